@@ -26,17 +26,26 @@
 #include "ascon/permutation.h"
 #include "ascon/aead.h"
 #include "ascon/aead-masked.h"
+#include "ascon/bloom.h"
+#include "ascon/chunker.h"
 #include "ascon/hash.h"
 #include "ascon/hkdf.h"
 #include "ascon/hmac.h"
 #include "ascon/isap.h"
+#include "ascon/kdf-tree.h"
+#include "ascon/keyed-hash.h"
 #include "ascon/kmac.h"
 #include "ascon/masking.h"
+#include "ascon/merkle.h"
+#include "ascon/multi-hash.h"
 #include "ascon/pbkdf2.h"
 #include "ascon/permutation.h"
 #include "ascon/prf.h"
+#include "ascon/prf-ctr.h"
 #include "ascon/random.h"
+#include "ascon/random-dist.h"
 #include "ascon/siv.h"
+#include "ascon/storage-file.h"
 #include "ascon/utility.h"
 #include "ascon/xof.h"
 
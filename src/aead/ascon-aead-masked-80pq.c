@@ -39,16 +39,7 @@ static void ascon80pq_masked_aead_init
     const ascon_masked_key_160_t *k)
 {
     /* Generate random words for use in permutation calls */
-#if ASCON_MASKED_KEY_SHARES == 2
-    preserve[0] = ascon_trng_generate_64(trng);
-#elif ASCON_MASKED_KEY_SHARES == 3
-    preserve[0] = ascon_trng_generate_64(trng);
-    preserve[1] = ascon_trng_generate_64(trng);
-#else
-    preserve[0] = ascon_trng_generate_64(trng);
-    preserve[1] = ascon_trng_generate_64(trng);
-    preserve[2] = ascon_trng_generate_64(trng);
-#endif
+    ascon_trng_generate_words_64(trng, preserve, ASCON_MASKED_KEY_SHARES - 1);
 
     /* Format the key and nonce into the initial state */
     ascon_masked_state_init(state);
@@ -89,16 +80,7 @@ static void ascon80pq_masked_aead_finalize
     const ascon_masked_key_160_t *k, unsigned char *tag)
 {
     /* Refresh the randomness for the final permutation call */
-#if ASCON_MASKED_KEY_SHARES == 2
-    preserve[0] = ascon_trng_generate_64(trng);
-#elif ASCON_MASKED_KEY_SHARES == 3
-    preserve[0] = ascon_trng_generate_64(trng);
-    preserve[1] = ascon_trng_generate_64(trng);
-#else
-    preserve[0] = ascon_trng_generate_64(trng);
-    preserve[1] = ascon_trng_generate_64(trng);
-    preserve[2] = ascon_trng_generate_64(trng);
-#endif
+    ascon_trng_generate_words_64(trng, preserve, ASCON_MASKED_KEY_SHARES - 1);
 
     /* Convert the data shares form back into the key shares form */
 #if ASCON_MASKED_DATA_SHARES == 1
@@ -0,0 +1,262 @@
+/*
+ * Copyright (C) 2023 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ASCON_BLOOM_H
+#define ASCON_BLOOM_H
+
+/**
+ * \file bloom.h
+ * \brief Bloom filters with indices derived from ASCON-XOF.
+ *
+ * A Bloom filter is a compact probabilistic set.  Querying the filter
+ * may report a false positive for a key that was never inserted, but
+ * it never reports a false negative for a key that was inserted.
+ *
+ * Each key needs k independent bit indices into the filter.  Rather than
+ * hashing the key k times, this module derives all of the indices from
+ * a single ASCON-cXOF squeeze.
+ *
+ * The filter is "blocked": each key selects a single 64 byte block and
+ * then sets or tests k bits within that block.  This means that each
+ * insert or query touches a single cache line.  The false positive rate
+ * is slightly higher than for a classic Bloom filter of the same size.
+ *
+ * The memory for the filter bits is supplied by the caller.  Filters
+ * can be serialized to a portable byte format with ascon_bloom_serialize()
+ * and loaded again with ascon_bloom_deserialize().
+ *
+ * \code
+ * static unsigned char bits[1024 * ASCON_BLOOM_BLOCK_SIZE];
+ * ascon_bloom_filter_t filter;
+ *
+ * ascon_bloom_init(&filter, bits, sizeof(bits), 7);
+ * ascon_bloom_insert(&filter, key, keylen);
+ * ...
+ * if (ascon_bloom_contains(&filter, key, keylen)) {
+ *     // The key may be in the set.
+ * }
+ * ascon_bloom_free(&filter);
+ * \endcode
+ *
+ * The indices are not keyed, so an attacker who can choose the keys can
+ * deliberately fill the filter.  Mix a secret into the keys before
+ * inserting them if that is a concern.
+ */
+
+#include <ascon/xof.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Size of a single block in a Bloom filter.
+ */
+#define ASCON_BLOOM_BLOCK_SIZE 64
+
+/**
+ * \brief Maximum number of bits to set per key in a Bloom filter.
+ */
+#define ASCON_BLOOM_MAX_HASHES 16
+
+/**
+ * \brief Size of the header on a serialized Bloom filter.
+ */
+#define ASCON_BLOOM_HEADER_SIZE 16
+
+/**
+ * \brief Computes the size of a serialized Bloom filter.
+ *
+ * \param num_blocks Number of blocks in the filter.
+ */
+#define ASCON_BLOOM_SERIALIZED_SIZE(num_blocks) \
+    (ASCON_BLOOM_HEADER_SIZE + (num_blocks) * ASCON_BLOOM_BLOCK_SIZE)
+
+/**
+ * \brief State information for a Bloom filter.
+ */
+typedef struct
+{
+    unsigned char *bits;        /**< Bits of the filter */
+    size_t num_blocks;          /**< Number of blocks in the filter */
+    unsigned k;                 /**< Number of bits to set per key */
+    ascon_xof_precomputed_t xof; /**< Pre-computed index derivation state */
+
+} ascon_bloom_filter_t;
+
+/**
+ * \brief Derives multiple indices within a range from a single key.
+ *
+ * \param indices Returns the indices.
+ * \param count Number of indices to derive.
+ * \param range Range for the indices, which must be non-zero.  Each index
+ * will be between 0 and \a range - 1.
+ * \param in Points to the key.
+ * \param inlen Length of the key in bytes.
+ *
+ * The indices are derived by squeezing 4 x \a count bytes from ASCON-cXOF
+ * with the function name "MultiIndex" in one call, and then reducing each
+ * 32-bit word into the range by multiplication rather than division.
+ */
+void ascon_multi_index
+    (uint32_t *indices, unsigned count, uint32_t range,
+     const unsigned char *in, size_t inlen);
+
+/**
+ * \brief Initializes an empty Bloom filter.
+ *
+ * \param filter The Bloom filter to initialize.
+ * \param bits Points to the memory to use to hold the bits of the filter.
+ * \param size Size of the \a bits memory in bytes.  This will be rounded
+ * down to a multiple of ASCON_BLOOM_BLOCK_SIZE.
+ * \param k Number of bits to set per key, between 1 and
+ * ASCON_BLOOM_MAX_HASHES.
+ *
+ * \return 0 on success, or -1 if \a size is less than
+ * ASCON_BLOOM_BLOCK_SIZE or \a k is out of range.
+ *
+ * The \a bits memory must remain valid until ascon_bloom_free() is called.
+ *
+ * \sa ascon_bloom_free(), ascon_bloom_insert(), ascon_bloom_contains()
+ */
+int ascon_bloom_init
+    (ascon_bloom_filter_t *filter, unsigned char *bits,
+     size_t size, unsigned k);
+
+/**
+ * \brief Frees a Bloom filter.
+ *
+ * \param filter The Bloom filter to free.
+ *
+ * The memory for the bits of the filter belongs to the caller and is
+ * not cleared by this function.
+ */
+void ascon_bloom_free(ascon_bloom_filter_t *filter);
+
+/**
+ * \brief Clears all keys from a Bloom filter.
+ *
+ * \param filter The Bloom filter to clear.
+ */
+void ascon_bloom_clear(ascon_bloom_filter_t *filter);
+
+/**
+ * \brief Inserts a key into a Bloom filter.
+ *
+ * \param filter The Bloom filter.
+ * \param in Points to the key to insert.
+ * \param inlen Length of the key in bytes.
+ *
+ * \sa ascon_bloom_insert_batch(), ascon_bloom_contains()
+ */
+void ascon_bloom_insert
+    (ascon_bloom_filter_t *filter, const unsigned char *in, size_t inlen);
+
+/**
+ * \brief Determines if a Bloom filter may contain a key.
+ *
+ * \param filter The Bloom filter.
+ * \param in Points to the key to query.
+ * \param inlen Length of the key in bytes.
+ *
+ * \return Non-zero if the key may be in the filter, or zero if the
+ * key is definitely not in the filter.
+ *
+ * \sa ascon_bloom_contains_batch(), ascon_bloom_insert()
+ */
+int ascon_bloom_contains
+    (const ascon_bloom_filter_t *filter, const unsigned char *in, size_t inlen);
+
+/**
+ * \brief Inserts an array of keys into a Bloom filter.
+ *
+ * \param filter The Bloom filter.
+ * \param in Array of pointers to the keys to insert.
+ * \param inlen Array of key lengths.
+ * \param count Number of keys to insert.
+ *
+ * This is equivalent to calling ascon_bloom_insert() for each key,
+ * but the blocks for a group of keys are located up front so that
+ * the memory accesses for the group can overlap.
+ *
+ * \sa ascon_bloom_insert()
+ */
+void ascon_bloom_insert_batch
+    (ascon_bloom_filter_t *filter, const unsigned char * const *in,
+     const size_t *inlen, size_t count);
+
+/**
+ * \brief Queries an array of keys against a Bloom filter.
+ *
+ * \param filter The Bloom filter.
+ * \param results Returns 1 for each key that may be in the filter,
+ * or 0 for each key that is definitely not in the filter.
+ * \param in Array of pointers to the keys to query.
+ * \param inlen Array of key lengths.
+ * \param count Number of keys to query.
+ *
+ * \return The number of keys that may be in the filter.
+ *
+ * \sa ascon_bloom_contains()
+ */
+size_t ascon_bloom_contains_batch
+    (const ascon_bloom_filter_t *filter, unsigned char *results,
+     const unsigned char * const *in, const size_t *inlen, size_t count);
+
+/**
+ * \brief Serializes a Bloom filter into a portable byte format.
+ *
+ * \param filter The Bloom filter to serialize.
+ * \param out Buffer to receive the serialized filter.
+ * \param outlen Length of the \a out buffer in bytes.
+ *
+ * \return 0 on success, or -1 if \a outlen is less than
+ * ASCON_BLOOM_SERIALIZED_SIZE(filter->num_blocks).
+ *
+ * \sa ascon_bloom_deserialize()
+ */
+int ascon_bloom_serialize
+    (const ascon_bloom_filter_t *filter, unsigned char *out, size_t outlen);
+
+/**
+ * \brief Initializes a Bloom filter from its serialized form.
+ *
+ * \param filter The Bloom filter to initialize.
+ * \param bits Points to the memory to use to hold the bits of the filter.
+ * \param size Size of the \a bits memory in bytes.
+ * \param in Points to the serialized filter.
+ * \param inlen Length of the serialized filter in bytes.
+ *
+ * \return 0 on success, or -1 if the serialized data is invalid or
+ * \a size is too small to hold the bits of the filter.
+ *
+ * \sa ascon_bloom_serialize()
+ */
+int ascon_bloom_deserialize
+    (ascon_bloom_filter_t *filter, unsigned char *bits, size_t size,
+     const unsigned char *in, size_t inlen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2023 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef ASCON_CHUNKER_H
+#define ASCON_CHUNKER_H
+
+/**
+ * \file chunker.h
+ * \brief Content-defined chunking with ASCON-HASH digests.
+ *
+ * The chunker splits a stream of data into variable-sized chunks whose
+ * boundaries depend upon the content of the data rather than its offset.
+ * Inserting or deleting bytes in the stream only changes the chunks
+ * around the edit, which makes this useful for deduplication.
+ *
+ * Boundaries are located with the "gear" rolling hash and the normalized
+ * chunking rules from FastCDC.  Each chunk is hashed with ASCON-HASH or
+ * ASCON-HASHA in the same pass that locates the boundary, so the data
+ * is only read once.
+ *
+ * \code
+ * ascon_chunker_state_t chunker;
+ * ascon_chunk_t chunk;
+ * const unsigned char *in = data;
+ * size_t inlen = data_len;
+ *
+ * ascon_chunker_init(&chunker, 0, 0, 0);
+ * while (ascon_chunker_update(&chunker, &in, &inlen, &chunk)) {
+ *     // Do something with the chunk.
+ * }
+ * // Repeat the above for any further data in the stream.
+ * if (ascon_chunker_finalize(&chunker, &chunk)) {
+ *     // Do something with the final chunk.
+ * }
+ * ascon_chunker_free(&chunker);
+ * \endcode
+ *
+ * References: https://www.usenix.org/conference/atc16/technical-sessions/presentation/xia
+ */
+
+#include <ascon/hash.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Default minimum size for chunks.
+ */
+#define ASCON_CHUNKER_MIN_SIZE 2048
+
+/**
+ * \brief Default average size for chunks.
+ */
+#define ASCON_CHUNKER_AVG_SIZE 8192
+
+/**
+ * \brief Default maximum size for chunks.
+ */
+#define ASCON_CHUNKER_MAX_SIZE 65536
+
+/**
+ * \brief Information about a chunk that was located in the input stream.
+ */
+typedef struct
+{
+    uint64_t offset;    /**< Offset of the chunk from the start of the stream */
+    size_t length;      /**< Length of the chunk in bytes */
+    unsigned char digest[ASCON_HASH_SIZE]; /**< Hash of the chunk's data */
+
+} ascon_chunk_t;
+
+/**
+ * \brief State information for the content-defined chunker.
+ */
+typedef struct
+{
+    /** Hash state for the current chunk */
+    union {
+        ascon_hash_state_t hash;    /**< ASCON-HASH state */
+        ascon_hasha_state_t hasha;  /**< ASCON-HASHA state */
+    } h;
+    uint64_t fingerprint;   /**< Rolling gear hash fingerprint */
+    uint64_t mask_small;    /**< Mask to use before the average size */
+    uint64_t mask_large;    /**< Mask to use after the average size */
+    uint64_t offset;        /**< Offset of the current chunk in the stream */
+    size_t length;          /**< Number of bytes in the current chunk */
+    size_t min_size;        /**< Minimum chunk size */
+    size_t avg_size;        /**< Average chunk size */
+    size_t max_size;        /**< Maximum chunk size */
+    unsigned char hasha;    /**< Non-zero to use ASCON-HASHA for digests */
+
+} ascon_chunker_state_t;
+
+/**
+ * \brief Initializes a content-defined chunker that uses ASCON-HASH
+ * to compute the chunk digests.
+ *
+ * \param state Chunker state to initialize.
+ * \param min_size Minimum size for chunks, or zero for the default.
+ * \param avg_size Average size for chunks, or zero for the default.
+ * \param max_size Maximum size for chunks, or zero for the default.
+ *
+ * The sizes will be adjusted if necessary so that \a min_size is less
+ * than or equal to \a avg_size and \a avg_size is less than or equal
+ * to \a max_size.  The \a avg_size is rounded down to a power of two.
+ *
+ * \sa ascon_chunker_init_hasha(), ascon_chunker_update()
+ */
+void ascon_chunker_init
+    (ascon_chunker_state_t *state, size_t min_size,
+     size_t avg_size, size_t max_size);
+
+/**
+ * \brief Initializes a content-defined chunker that uses ASCON-HASHA
+ * to compute the chunk digests.
+ *
+ * \param state Chunker state to initialize.
+ * \param min_size Minimum size for chunks, or zero for the default.
+ * \param avg_size Average size for chunks, or zero for the default.
+ * \param max_size Maximum size for chunks, or zero for the default.
+ *
+ * \sa ascon_chunker_init(), ascon_chunker_update()
+ */
+void ascon_chunker_init_hasha
+    (ascon_chunker_state_t *state, size_t min_size,
+     size_t avg_size, size_t max_size);
+
+/**
+ * \brief Frees a content-defined chunker and destroys any
+ * sensitive material.
+ *
+ * \param state Chunker state to be freed.
+ */
+void ascon_chunker_free(ascon_chunker_state_t *state);
+
+/**
+ * \brief Feeds more data from the stream into a content-defined chunker.
+ *
+ * \param state Chunker state.
+ * \param in Points to a pointer to the input data.  On exit, this
+ * is advanced past the data that was consumed.
+ * \param inlen Points to the number of bytes of input data.  On exit,
+ * this is reduced by the number of bytes that were consumed.
+ * \param chunk Returns information about the chunk that was completed.
+ *
+ * \return Non-zero if a chunk boundary was found, or zero if all of the
+ * input data was consumed without finding a boundary.
+ *
+ * The function stops at the first chunk boundary that it finds.
+ * The caller should keep calling this function with the updated
+ * \a in and \a inlen values until it returns zero.
+ *
+ * The boundaries that are found do not depend upon how the stream
+ * is split into buffers across calls to this function.
+ *
+ * \sa ascon_chunker_finalize()
+ */
+int ascon_chunker_update
+    (ascon_chunker_state_t *state, const unsigned char **in,
+     size_t *inlen, ascon_chunk_t *chunk);
+
+/**
+ * \brief Finalizes a content-defined chunker at the end of the stream.
+ *
+ * \param state Chunker state.
+ * \param chunk Returns information about the final chunk.
+ *
+ * \return Non-zero if there was a final chunk, or zero if the stream
+ * ended on a chunk boundary.
+ *
+ * On exit, the chunker is reset to process a new stream from offset zero.
+ *
+ * \sa ascon_chunker_update()
+ */
+int ascon_chunker_finalize
+    (ascon_chunker_state_t *state, ascon_chunk_t *chunk);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
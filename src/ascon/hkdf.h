@@ -23,6 +23,7 @@
 #ifndef ASCON_HKDF_H
 #define ASCON_HKDF_H
 
+#include <ascon/hmac.h>
 #include <stddef.h>
 
 /**
@@ -80,6 +81,53 @@ typedef struct
 
 } ascon_hkdfa_state_t;
 
+/**
+ * \brief Context for ASCON-HKDF with cached HMAC states for the
+ * pseudorandom key (PRK).
+ *
+ * This structure should be treated as opaque.
+ */
+typedef struct
+{
+    /** Pre-computed HMAC key context for the PRK */
+    ascon_hmac_key_t prk;
+
+} ascon_hkdf_context_t;
+
+/**
+ * \brief Context for ASCON-HKDFA with cached HMAC states for the
+ * pseudorandom key (PRK).
+ *
+ * This structure should be treated as opaque.
+ */
+typedef struct
+{
+    /** Pre-computed HMAC key context for the PRK */
+    ascon_hmaca_key_t prk;
+
+} ascon_hkdfa_context_t;
+
+/**
+ * \brief Describes one labelled output for expansion with
+ * ascon_hkdf_context_expand_labels() or ascon_hkdfa_context_expand_labels().
+ */
+typedef struct
+{
+    /** Points to the informational data for this output */
+    const unsigned char *info;
+
+    /** Number of bytes in the informational data */
+    size_t infolen;
+
+    /** Points to the buffer to receive the key material */
+    unsigned char *out;
+
+    /** Number of bytes of key material to generate, maximum of
+     *  ASCON_HKDF_OUTPUT_SIZE * 255 bytes */
+    size_t outlen;
+
+} ascon_hkdf_label_t;
+
 /**
  * \brief Derives key material using ASCON-HKDF.
  *
@@ -143,6 +191,77 @@ int ascon_hkdf_expand
  */
 void ascon_hkdf_free(ascon_hkdf_state_t *state);
 
+/**
+ * \brief Initializes an ASCON-HKDF context from a key and salt.
+ *
+ * \param context HKDF context to be initialized.
+ * \param key Points to the bytes of the key.
+ * \param keylen Number of bytes in the key.
+ * \param salt Points to the bytes of the salt.
+ * \param saltlen Number of bytes in the salt.
+ *
+ * This performs the same extraction step as ascon_hkdf_extract(), and
+ * then pre-computes the HMAC states for the resulting PRK.  Every block
+ * of every later expansion starts from those states instead of hashing
+ * the PRK again.
+ *
+ * \sa ascon_hkdf_context_expand_labels(), ascon_hkdf_context_free()
+ */
+void ascon_hkdf_context_init
+    (ascon_hkdf_context_t *context,
+     const unsigned char *key, size_t keylen,
+     const unsigned char *salt, size_t saltlen);
+
+/**
+ * \brief Frees all sensitive material in an ASCON-HKDF context.
+ *
+ * \param context Points to the HKDF context.
+ */
+void ascon_hkdf_context_free(ascon_hkdf_context_t *context);
+
+/**
+ * \brief Expands key material for a single label using an ASCON-HKDF
+ * context.
+ *
+ * \param context HKDF context to use to expand key material.
+ * \param info Points to the bytes of the informational data.
+ * \param infolen Number of bytes in the informational data.
+ * \param out Points to the output buffer to receive the key material.
+ * \param outlen Number of bytes of key material to generate, maximum of
+ * ASCON_HKDF_OUTPUT_SIZE * 255 bytes.
+ *
+ * \return Zero on success or -1 if \a outlen is out of range.
+ *
+ * The output is identical to ascon_hkdf() with the same key, salt, and
+ * info.  The \a context is not modified and can be used to expand any
+ * number of labels.
+ */
+int ascon_hkdf_context_expand
+    (const ascon_hkdf_context_t *context,
+     const unsigned char *info, size_t infolen,
+     unsigned char *out, size_t outlen);
+
+/**
+ * \brief Expands key material for several labels using an ASCON-HKDF
+ * context.
+ *
+ * \param context HKDF context to use to expand key material.
+ * \param labels Array of labels to expand.
+ * \param count Number of labels in the array.
+ *
+ * \return Zero on success or -1 if one of the output lengths is out of
+ * range, in which case no key material is generated.
+ *
+ * Each output is identical to calling ascon_hkdf_context_expand() for
+ * its label.  The labels are independent, so on platforms that support
+ * it, adjacent labels with the same info length are expanded side by
+ * side with interleaved permutation calls.  Labels like "client key"
+ * and "server key" therefore benefit from being next to each other.
+ */
+int ascon_hkdf_context_expand_labels
+    (const ascon_hkdf_context_t *context,
+     const ascon_hkdf_label_t *labels, size_t count);
+
 /**
  * \brief Derives key material using ASCON-HKDFA.
  *
@@ -206,6 +325,75 @@ int ascon_hkdfa_expand
  */
 void ascon_hkdfa_free(ascon_hkdfa_state_t *state);
 
+/**
+ * \brief Initializes an ASCON-HKDFA context from a key and salt.
+ *
+ * \param context HKDF context to be initialized.
+ * \param key Points to the bytes of the key.
+ * \param keylen Number of bytes in the key.
+ * \param salt Points to the bytes of the salt.
+ * \param saltlen Number of bytes in the salt.
+ *
+ * This performs the same extraction step as ascon_hkdfa_extract(), and
+ * then pre-computes the HMAC states for the resulting PRK.  Every block
+ * of every later expansion starts from those states instead of hashing
+ * the PRK again.
+ *
+ * \sa ascon_hkdfa_context_expand_labels(), ascon_hkdfa_context_free()
+ */
+void ascon_hkdfa_context_init
+    (ascon_hkdfa_context_t *context,
+     const unsigned char *key, size_t keylen,
+     const unsigned char *salt, size_t saltlen);
+
+/**
+ * \brief Frees all sensitive material in an ASCON-HKDFA context.
+ *
+ * \param context Points to the HKDF context.
+ */
+void ascon_hkdfa_context_free(ascon_hkdfa_context_t *context);
+
+/**
+ * \brief Expands key material for a single label using an ASCON-HKDFA
+ * context.
+ *
+ * \param context HKDF context to use to expand key material.
+ * \param info Points to the bytes of the informational data.
+ * \param infolen Number of bytes in the informational data.
+ * \param out Points to the output buffer to receive the key material.
+ * \param outlen Number of bytes of key material to generate, maximum of
+ * ASCON_HKDF_OUTPUT_SIZE * 255 bytes.
+ *
+ * \return Zero on success or -1 if \a outlen is out of range.
+ *
+ * The output is identical to ascon_hkdfa() with the same key, salt, and
+ * info.  The \a context is not modified and can be used to expand any
+ * number of labels.
+ */
+int ascon_hkdfa_context_expand
+    (const ascon_hkdfa_context_t *context,
+     const unsigned char *info, size_t infolen,
+     unsigned char *out, size_t outlen);
+
+/**
+ * \brief Expands key material for several labels using an ASCON-HKDFA
+ * context.
+ *
+ * \param context HKDF context to use to expand key material.
+ * \param labels Array of labels to expand.
+ * \param count Number of labels in the array.
+ *
+ * \return Zero on success or -1 if one of the output lengths is out of
+ * range, in which case no key material is generated.
+ *
+ * Each output is identical to calling ascon_hkdfa_context_expand() for
+ * its label.  The HMAC states for the PRK are shared by all of the
+ * labels.
+ */
+int ascon_hkdfa_context_expand_labels
+    (const ascon_hkdfa_context_t *context,
+     const ascon_hkdf_label_t *labels, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -75,6 +75,30 @@ typedef struct
 
 } ascon_hmaca_state_t;
 
+/**
+ * \brief Pre-computed key context for ASCON-HMAC.
+ *
+ * The context holds the hash states after absorbing the inner and outer
+ * padded key blocks.  Each message then starts from a copy of these
+ * states rather than re-absorbing the key blocks.
+ */
+typedef struct
+{
+    ascon_hmac_state_t inner;   /**< State after the inner key block */
+    ascon_hmac_state_t outer;   /**< State after the outer key block */
+
+} ascon_hmac_key_t;
+
+/**
+ * \brief Pre-computed key context for ASCON-HMACA.
+ */
+typedef struct
+{
+    ascon_hmaca_state_t inner;  /**< State after the inner key block */
+    ascon_hmaca_state_t outer;  /**< State after the outer key block */
+
+} ascon_hmaca_key_t;
+
 /**
  * \brief Computes a HMAC value using ASCON-HASH.
  *
@@ -157,6 +181,111 @@ void ascon_hmac_finalize
     (ascon_hmac_state_t *state, const unsigned char *key, size_t keylen,
      unsigned char *out);
 
+/**
+ * \brief Pre-computes the key context for ASCON-HMAC.
+ *
+ * \param key Points to the key context to be initialized.
+ * \param k Points to the key.
+ * \param keylen Number of bytes in the key.
+ *
+ * The key context must be freed with ascon_hmac_key_free() when it
+ * is no longer required.
+ *
+ * \sa ascon_hmac_init_precomputed(), ascon_hmac_with_key()
+ */
+void ascon_hmac_key_init
+    (ascon_hmac_key_t *key, const unsigned char *k, size_t keylen);
+
+/**
+ * \brief Frees an ASCON-HMAC key context and destroys any
+ * sensitive material.
+ *
+ * \param key Key context to be freed.
+ */
+void ascon_hmac_key_free(ascon_hmac_key_t *key);
+
+/**
+ * \brief Computes a HMAC value using ASCON-HASH and a pre-computed key.
+ *
+ * \param out Buffer to receive the output HMAC value; must be at least
+ * ASCON_HMAC_SIZE bytes in length.
+ * \param key Points to the pre-computed key context.
+ * \param in Points to the data to authenticate.
+ * \param inlen Number of bytes of data to authenticate.
+ *
+ * The output is identical to ascon_hmac() with the original key.
+ */
+void ascon_hmac_with_key
+    (unsigned char *out, const ascon_hmac_key_t *key,
+     const unsigned char *in, size_t inlen);
+
+/**
+ * \brief Initializes an incremental HMAC state using ASCON-HASH and
+ * a pre-computed key.
+ *
+ * \param state Points to the state to be initialized.
+ * \param key Points to the pre-computed key context.
+ *
+ * The \a key must be preserved until the ascon_hmac_finalize_precomputed()
+ * call to provide the outer HMAC hashing state.
+ *
+ * \sa ascon_hmac_update(), ascon_hmac_finalize_precomputed()
+ */
+void ascon_hmac_init_precomputed
+    (ascon_hmac_state_t *state, const ascon_hmac_key_t *key);
+
+/**
+ * \brief Re-initializes an incremental HMAC state using ASCON-HASH and
+ * a pre-computed key.
+ *
+ * \param state Points to the state to be re-initialized.
+ * \param key Points to the pre-computed key context.
+ *
+ * This function is equivalent to calling ascon_hmac_free() followed by
+ * ascon_hmac_init_precomputed().
+ */
+void ascon_hmac_reinit_precomputed
+    (ascon_hmac_state_t *state, const ascon_hmac_key_t *key);
+
+/**
+ * \brief Finalizes an incremental ASCON-HMAC state that was initialized
+ * with a pre-computed key.
+ *
+ * \param state HMAC state to squeeze the output data from.
+ * \param key Points to the pre-computed key context.
+ * \param out Points to the output buffer to receive the HMAC value;
+ * must be at least ASCON_HMAC_SIZE bytes in length.
+ *
+ * \sa ascon_hmac_init_precomputed(), ascon_hmac_update()
+ */
+void ascon_hmac_finalize_precomputed
+    (ascon_hmac_state_t *state, const ascon_hmac_key_t *key,
+     unsigned char *out);
+
+/**
+ * \brief Verifies a batch of ASCON-HMAC tags.
+ *
+ * \param results Bitmap to receive the results, which must be at least
+ * (\a count + 7) / 8 bytes in length.  Bit (i % 8) of byte (i / 8) is
+ * set to 1 if tag i is correct, or 0 if tag i is incorrect.
+ * \param tag Array of \a count pointers to the ASCON_HMAC_SIZE byte tags.
+ * \param in Array of \a count pointers to the data to authenticate.
+ * \param inlen Array of \a count data lengths.
+ * \param key Array of \a count pointers to the keys.
+ * \param keylen Array of \a count key lengths.
+ * \param count Number of items in the batch.
+ *
+ * \return 0 if all tags are correct, or -1 if at least one is incorrect.
+ *
+ * Each tag is checked in constant time.  When consecutive items use the
+ * same key pointer and length, the key context is computed only once
+ * for the run of items, so batches should be grouped by key if possible.
+ */
+int ascon_hmac_verify_batch
+    (unsigned char *results, const unsigned char *const *tag,
+     const unsigned char *const *in, const size_t *inlen,
+     const unsigned char *const *key, const size_t *keylen, size_t count);
+
 /**
  * \brief Computes a HMAC value using ASCON-HASHA.
  *
@@ -239,6 +368,111 @@ void ascon_hmaca_finalize
     (ascon_hmaca_state_t *state, const unsigned char *key, size_t keylen,
      unsigned char *out);
 
+/**
+ * \brief Pre-computes the key context for ASCON-HMACA.
+ *
+ * \param key Points to the key context to be initialized.
+ * \param k Points to the key.
+ * \param keylen Number of bytes in the key.
+ *
+ * The key context must be freed with ascon_hmaca_key_free() when it
+ * is no longer required.
+ *
+ * \sa ascon_hmaca_init_precomputed(), ascon_hmaca_with_key()
+ */
+void ascon_hmaca_key_init
+    (ascon_hmaca_key_t *key, const unsigned char *k, size_t keylen);
+
+/**
+ * \brief Frees an ASCON-HMACA key context and destroys any
+ * sensitive material.
+ *
+ * \param key Key context to be freed.
+ */
+void ascon_hmaca_key_free(ascon_hmaca_key_t *key);
+
+/**
+ * \brief Computes a HMAC value using ASCON-HASHA and a pre-computed key.
+ *
+ * \param out Buffer to receive the output HMAC value; must be at least
+ * ASCON_HMACA_SIZE bytes in length.
+ * \param key Points to the pre-computed key context.
+ * \param in Points to the data to authenticate.
+ * \param inlen Number of bytes of data to authenticate.
+ *
+ * The output is identical to ascon_hmaca() with the original key.
+ */
+void ascon_hmaca_with_key
+    (unsigned char *out, const ascon_hmaca_key_t *key,
+     const unsigned char *in, size_t inlen);
+
+/**
+ * \brief Initializes an incremental HMAC state using ASCON-HASHA and
+ * a pre-computed key.
+ *
+ * \param state Points to the state to be initialized.
+ * \param key Points to the pre-computed key context.
+ *
+ * The \a key must be preserved until the ascon_hmaca_finalize_precomputed()
+ * call to provide the outer HMAC hashing state.
+ *
+ * \sa ascon_hmaca_update(), ascon_hmaca_finalize_precomputed()
+ */
+void ascon_hmaca_init_precomputed
+    (ascon_hmaca_state_t *state, const ascon_hmaca_key_t *key);
+
+/**
+ * \brief Re-initializes an incremental HMAC state using ASCON-HASHA and
+ * a pre-computed key.
+ *
+ * \param state Points to the state to be re-initialized.
+ * \param key Points to the pre-computed key context.
+ *
+ * This function is equivalent to calling ascon_hmaca_free() followed by
+ * ascon_hmaca_init_precomputed().
+ */
+void ascon_hmaca_reinit_precomputed
+    (ascon_hmaca_state_t *state, const ascon_hmaca_key_t *key);
+
+/**
+ * \brief Finalizes an incremental ASCON-HMACA state that was initialized
+ * with a pre-computed key.
+ *
+ * \param state HMAC state to squeeze the output data from.
+ * \param key Points to the pre-computed key context.
+ * \param out Points to the output buffer to receive the HMAC value;
+ * must be at least ASCON_HMACA_SIZE bytes in length.
+ *
+ * \sa ascon_hmaca_init_precomputed(), ascon_hmaca_update()
+ */
+void ascon_hmaca_finalize_precomputed
+    (ascon_hmaca_state_t *state, const ascon_hmaca_key_t *key,
+     unsigned char *out);
+
+/**
+ * \brief Verifies a batch of ASCON-HMACA tags.
+ *
+ * \param results Bitmap to receive the results, which must be at least
+ * (\a count + 7) / 8 bytes in length.  Bit (i % 8) of byte (i / 8) is
+ * set to 1 if tag i is correct, or 0 if tag i is incorrect.
+ * \param tag Array of \a count pointers to the ASCON_HMACA_SIZE byte tags.
+ * \param in Array of \a count pointers to the data to authenticate.
+ * \param inlen Array of \a count data lengths.
+ * \param key Array of \a count pointers to the keys.
+ * \param keylen Array of \a count key lengths.
+ * \param count Number of items in the batch.
+ *
+ * \return 0 if all tags are correct, or -1 if at least one is incorrect.
+ *
+ * Each tag is checked in constant time.  When consecutive items use the
+ * same key pointer and length, the key context is computed only once
+ * for the run of items, so batches should be grouped by key if possible.
+ */
+int ascon_hmaca_verify_batch
+    (unsigned char *results, const unsigned char *const *tag,
+     const unsigned char *const *in, const size_t *inlen,
+     const unsigned char *const *key, const size_t *keylen, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2023 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef ASCON_KDF_TREE_H
+#define ASCON_KDF_TREE_H
+
+/**
+ * \file kdf-tree.h
+ * \brief Key hierarchies with a cache of intermediate keys.
+ *
+ * Multi-tenant applications often derive keys along a path from a root
+ * key; for example root -> tenant -> purpose -> epoch.  Each step in the
+ * path is a call to ascon_kdf() with the parent key as the key and the
+ * label for that step as the customization string:
+ *
+ * \code
+ * K[0] = root
+ * K[i] = ascon_kdf(ASCON_KDF_TREE_KEY_SIZE, K[i-1], label[i])
+ * \endcode
+ *
+ * A key derivation tree remembers the most recently used intermediate
+ * keys in a fixed-size least recently used (LRU) cache so that lookups
+ * of hot tenant keys do not need to re-run the KDF for every step.
+ * Derivation resumes from the deepest cached prefix of the requested path.
+ *
+ * The memory for the cache entries is supplied by the caller.  Lookups
+ * and evictions always scan every entry and select the result with
+ * masks, and insertions rewrite every entry with a masked select, so the
+ * access pattern does not reveal which entry was hit or which entry was
+ * evicted.  Evicted entries are overwritten in full when they are reused.
+ * Explicitly forgetting entries with ascon_kdf_tree_forget() is not
+ * constant-time.
+ *
+ * \code
+ * static ascon_kdf_tree_entry_t entries[32];
+ * ascon_kdf_tree_t tree;
+ * const unsigned char *labels[2] = {tenant, "storage"};
+ * size_t labellens[2] = {tenantlen, 7};
+ * unsigned char key[ASCON_KDF_TREE_KEY_SIZE];
+ *
+ * ascon_kdf_tree_init(&tree, root, sizeof(root), entries, 32);
+ * ascon_kdf_tree_derive(&tree, key, labels, labellens, 2);
+ * ...
+ * ascon_kdf_tree_free(&tree);
+ * \endcode
+ */
+
+#include <ascon/kdf.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Size of the root key and every derived key in a key
+ * derivation tree.
+ */
+#define ASCON_KDF_TREE_KEY_SIZE 32
+
+/**
+ * \brief Maximum size of an encoded path in a key derivation tree.
+ *
+ * Each label in a path is encoded as a length byte followed by the
+ * label bytes, so a path of depth d may have up to
+ * ASCON_KDF_TREE_MAX_PATH - d bytes of labels.
+ */
+#define ASCON_KDF_TREE_MAX_PATH 96
+
+/**
+ * \brief Entry in the cache for a key derivation tree.
+ *
+ * The application should treat the contents of this structure as opaque.
+ */
+typedef struct
+{
+    unsigned char key[ASCON_KDF_TREE_KEY_SIZE]; /**< Derived key */
+    unsigned char path[ASCON_KDF_TREE_MAX_PATH]; /**< Encoded path */
+    size_t pathlen;         /**< Length of the encoded path, 0 if empty */
+    uint64_t last_used;     /**< Time that the entry was last used */
+
+} ascon_kdf_tree_entry_t;
+
+/**
+ * \brief State information for a key derivation tree.
+ */
+typedef struct
+{
+    unsigned char root[ASCON_KDF_TREE_KEY_SIZE]; /**< Root key */
+    size_t rootlen;                     /**< Length of the root key */
+    ascon_kdf_tree_entry_t *entries;    /**< Entries in the cache */
+    size_t num_entries;                 /**< Number of cache entries */
+    uint64_t clock;                     /**< LRU clock for the cache */
+
+} ascon_kdf_tree_t;
+
+/**
+ * \brief Initializes a key derivation tree.
+ *
+ * \param tree The key derivation tree to initialize.
+ * \param root Points to the root key.
+ * \param rootlen Length of the root key, up to ASCON_KDF_TREE_KEY_SIZE.
+ * \param entries Points to the memory to use for the cache entries.
+ * \param num_entries Number of entries in \a entries, which may be zero
+ * to disable caching.
+ *
+ * \return 0 on success, or -1 if \a rootlen is too long.
+ *
+ * The \a entries memory must remain valid until ascon_kdf_tree_free()
+ * is called.
+ *
+ * \sa ascon_kdf_tree_free(), ascon_kdf_tree_derive()
+ */
+int ascon_kdf_tree_init
+    (ascon_kdf_tree_t *tree, const unsigned char *root, size_t rootlen,
+     ascon_kdf_tree_entry_t *entries, size_t num_entries);
+
+/**
+ * \brief Frees a key derivation tree and destroys all cached keys.
+ *
+ * \param tree The key derivation tree to free.
+ *
+ * \sa ascon_kdf_tree_init()
+ */
+void ascon_kdf_tree_free(ascon_kdf_tree_t *tree);
+
+/**
+ * \brief Derives the key at the end of a path in a key derivation tree.
+ *
+ * \param tree The key derivation tree.
+ * \param key Points to the buffer to receive the derived key, which must
+ * be at least ASCON_KDF_TREE_KEY_SIZE bytes in length.
+ * \param labels Points to an array of \a depth labels, one per level.
+ * \param labellens Points to an array of \a depth label lengths.  Each
+ * label may be up to 255 bytes in length.
+ * \param depth Number of levels in the path, which must be at least 1.
+ *
+ * \return 0 on success, or -1 if \a depth is zero, a label is too long,
+ * or the encoded path is longer than ASCON_KDF_TREE_MAX_PATH.
+ *
+ * The key is derived from the deepest prefix of the path that is in the
+ * cache, or from the root key if there is no such prefix.  The keys for
+ * the remaining levels are added to the cache, evicting the least
+ * recently used entries if necessary.
+ *
+ * The result is identical to chaining ascon_kdf() calls from the root
+ * key with an output length of ASCON_KDF_TREE_KEY_SIZE.
+ */
+int ascon_kdf_tree_derive
+    (ascon_kdf_tree_t *tree, unsigned char *key,
+     const unsigned char *const *labels, const size_t *labellens,
+     size_t depth);
+
+/**
+ * \brief Removes a path and all of its descendants from the cache
+ * for a key derivation tree.
+ *
+ * \param tree The key derivation tree.
+ * \param labels Points to an array of \a depth labels, one per level.
+ * \param labellens Points to an array of \a depth label lengths.
+ * \param depth Number of levels in the path.  If this is zero, then
+ * all entries are removed from the cache.
+ *
+ * This can be used to forget the keys for a tenant after it has been
+ * deleted or after its keys have been rotated.  The removed entries
+ * are wiped with ascon_clean().
+ */
+void ascon_kdf_tree_forget
+    (ascon_kdf_tree_t *tree, const unsigned char *const *labels,
+     const size_t *labellens, size_t depth);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
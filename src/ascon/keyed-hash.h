@@ -0,0 +1,278 @@
+/*
+ * Copyright (C) 2023 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef ASCON_KEYED_HASH_H
+#define ASCON_KEYED_HASH_H
+
+/**
+ * \file keyed-hash.h
+ * \brief Keyed 64-bit hashing for hash tables based on ASCON-Prf.
+ *
+ * Hash tables that are indexed by attacker-controlled keys can be forced
+ * into worst-case behaviour if the attacker can predict which keys will
+ * collide.  The usual defence is to hash the keys with a keyed PRF using
+ * a secret key that is chosen at random when the table is created.
+ *
+ * The functions in this module provide such a keyed hash with a 64-bit
+ * output.  Inputs of 16 bytes or less are processed with ASCON-PrfShort,
+ * which needs only a single permutation call.  Longer inputs are processed
+ * with ASCON-Prf in fixed-length output mode.  The 64-bit result is the
+ * first 8 bytes of the PRF output in big-endian byte order.
+ *
+ * \code
+ * ascon_keyed_hash_key_t key;
+ * unsigned char k[ASCON_KEYED_HASH_KEY_SIZE];
+ * ascon_random(k, sizeof(k));
+ * ascon_keyed_hash_key_init(&key, k);
+ * ...
+ * bucket = ascon_keyed_hash64(&key, name, strlen(name)) % num_buckets;
+ * ...
+ * ascon_keyed_hash_key_free(&key);
+ * \endcode
+ *
+ * In C++, ascon::keyed_hash can be used as the hasher for
+ * std::unordered_map and std::unordered_set.
+ *
+ * References: https://eprint.iacr.org/2021/1574
+ */
+
+#include <ascon/prf.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Size of the key for the keyed hash in bytes.
+ */
+#define ASCON_KEYED_HASH_KEY_SIZE ASCON_PRF_SHORT_KEY_SIZE
+
+/**
+ * \brief Key for the keyed 64-bit hash.
+ */
+typedef struct
+{
+    unsigned char k[ASCON_KEYED_HASH_KEY_SIZE]; /**< Key material */
+
+} ascon_keyed_hash_key_t;
+
+/**
+ * \brief Initializes a keyed hash key.
+ *
+ * \param key The key object to initialize.
+ * \param k Points to the ASCON_KEYED_HASH_KEY_SIZE bytes of the key.
+ *
+ * The key should be generated at random, for example with ascon_random(),
+ * and kept secret from anyone who can choose the inputs to the hash.
+ *
+ * \sa ascon_keyed_hash_key_free()
+ */
+void ascon_keyed_hash_key_init
+    (ascon_keyed_hash_key_t *key, const unsigned char *k);
+
+/**
+ * \brief Frees a keyed hash key and destroys all sensitive material.
+ *
+ * \param key The key object to free.
+ */
+void ascon_keyed_hash_key_free(ascon_keyed_hash_key_t *key);
+
+/**
+ * \brief Computes the keyed 64-bit hash of a block of data.
+ *
+ * \param key The key to use to hash the data.
+ * \param in Points to the data to be hashed.
+ * \param inlen Number of bytes of data to be hashed.
+ *
+ * \return The 64-bit hash value.
+ *
+ * If \a inlen is ASCON_PRF_SHORT_MAX_INPUT_SIZE or less, then the result
+ * is the same as ascon_prf_short() with an 8 byte output.  Otherwise the
+ * result is the same as ascon_prf_fixed() with an 8 byte output.
+ *
+ * \sa ascon_keyed_hash64_u64(), ascon_keyed_hash64_u128()
+ */
+uint64_t ascon_keyed_hash64
+    (const ascon_keyed_hash_key_t *key, const unsigned char *in, size_t inlen);
+
+/**
+ * \brief Computes the keyed 64-bit hash of a 64-bit integer value.
+ *
+ * \param key The key to use to hash the value.
+ * \param value The value to be hashed.
+ *
+ * \return The 64-bit hash value.
+ *
+ * This is equivalent to calling ascon_keyed_hash64() on the 8 bytes of
+ * \a value in big-endian byte order, but avoids the conversion overhead
+ * on platforms where the permutation state is word-oriented.
+ *
+ * \sa ascon_keyed_hash64(), ascon_keyed_hash64_u128()
+ */
+uint64_t ascon_keyed_hash64_u64
+    (const ascon_keyed_hash_key_t *key, uint64_t value);
+
+/**
+ * \brief Computes the keyed 64-bit hash of a 128-bit value that is
+ * supplied as two 64-bit words.
+ *
+ * \param key The key to use to hash the value.
+ * \param high The high 64 bits of the value to be hashed.
+ * \param low The low 64 bits of the value to be hashed.
+ *
+ * \return The 64-bit hash value.
+ *
+ * This is equivalent to calling ascon_keyed_hash64() on the 16 bytes of
+ * \a high and \a low in big-endian byte order.
+ *
+ * \sa ascon_keyed_hash64(), ascon_keyed_hash64_u64()
+ */
+uint64_t ascon_keyed_hash64_u128
+    (const ascon_keyed_hash_key_t *key, uint64_t high, uint64_t low);
+
+#ifdef __cplusplus
+} /* extern "C" */
+
+#include <ascon/random.h>
+#include <ascon/utility.h>
+
+#if !defined(ASCON_NO_STL) || defined(ASCON_SUITE_DOC)
+#include <string>
+#include <type_traits>
+#endif
+
+namespace ascon
+{
+
+/**
+ * \brief Keyed hash function object that can be used in place of
+ * std::hash for hash tables.
+ *
+ * \code
+ * std::unordered_map<std::string, int, ascon::keyed_hash> table;
+ * \endcode
+ *
+ * A default-constructed object uses a random key from ascon_random().
+ * Copies of the object share the same key, so a hash table and its
+ * copies will agree on the bucket for each key.
+ */
+class keyed_hash
+{
+public:
+    /**
+     * \brief Constructs a new keyed hash object with a random key.
+     */
+    inline keyed_hash()
+    {
+        unsigned char k[ASCON_KEYED_HASH_KEY_SIZE];
+        ::ascon_random(k, sizeof(k));
+        ::ascon_keyed_hash_key_init(&m_key, k);
+        ::ascon_clean(k, sizeof(k));
+    }
+
+    /**
+     * \brief Constructs a new keyed hash object with a specific key.
+     *
+     * \param k Points to the ASCON_KEYED_HASH_KEY_SIZE bytes of the key.
+     */
+    inline explicit keyed_hash(const unsigned char *k)
+    {
+        ::ascon_keyed_hash_key_init(&m_key, k);
+    }
+
+    /**
+     * \brief Destroys this keyed hash object.
+     */
+    inline ~keyed_hash()
+    {
+        ::ascon_keyed_hash_key_free(&m_key);
+    }
+
+    /**
+     * \brief Hashes a block of data.
+     *
+     * \param data Points to the data to be hashed.
+     * \param len Number of bytes of data to be hashed.
+     *
+     * \return The hash value, truncated to the size of size_t.
+     */
+    inline size_t operator()(const unsigned char *data, size_t len) const
+    {
+        return (size_t)::ascon_keyed_hash64(&m_key, data, len);
+    }
+
+    /**
+     * \brief Hashes a byte array.
+     *
+     * \param data The byte array to be hashed.
+     *
+     * \return The hash value, truncated to the size of size_t.
+     */
+    inline size_t operator()(const ascon::byte_array &data) const
+    {
+        return (size_t)::ascon_keyed_hash64(&m_key, data.data(), data.size());
+    }
+
+#if !defined(ASCON_NO_STL) || defined(ASCON_SUITE_DOC)
+
+    /**
+     * \brief Hashes a string.
+     *
+     * \param str The string to be hashed.
+     *
+     * \return The hash value, truncated to the size of size_t.
+     */
+    inline size_t operator()(const std::string &str) const
+    {
+        return (size_t)::ascon_keyed_hash64
+            (&m_key, (const unsigned char *)str.data(), str.size());
+    }
+
+    /**
+     * \brief Hashes an integer or enumerated value.
+     *
+     * \param value The value to be hashed.
+     *
+     * \return The hash value, truncated to the size of size_t.
+     *
+     * The value is converted into a 64-bit integer before being hashed,
+     * so equal values of different integer types hash to the same value.
+     */
+    template <typename T>
+    inline typename std::enable_if
+        <std::is_integral<T>::value || std::is_enum<T>::value, size_t>::type
+            operator()(T value) const
+    {
+        return (size_t)::ascon_keyed_hash64_u64(&m_key, (uint64_t)value);
+    }
+
+#endif /* !ASCON_NO_STL */
+
+private:
+    ascon_keyed_hash_key_t m_key;
+};
+
+} /* namespace ascon */
+
+#endif /* __cplusplus */
+
+#endif
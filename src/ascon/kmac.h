@@ -75,6 +75,28 @@ typedef struct
 
 } ascon_kmaca_state_t;
 
+/**
+ * \brief Pre-computed key context for ASCON-KMAC.
+ *
+ * This structure should be treated as opaque.
+ */
+typedef struct
+{
+    ascon_xof_state_t xof;  /**< ASCON-XOF state after absorbing the key */
+
+} ascon_kmac_key_t;
+
+/**
+ * \brief Pre-computed key context for ASCON-KMACA.
+ *
+ * This structure should be treated as opaque.
+ */
+typedef struct
+{
+    ascon_xofa_state_t xof; /**< ASCON-XOFA state after absorbing the key */
+
+} ascon_kmaca_key_t;
+
 /**
  * \brief Computes a KMAC value using ASCON-XOF.
  *
@@ -131,6 +153,132 @@ void ascon_kmac_reinit
     (ascon_kmac_state_t *state, const unsigned char *key, size_t keylen,
      const unsigned char *custom, size_t customlen, size_t outlen);
 
+/**
+ * \brief Pre-computes the initial KMAC state for a customization string
+ * and output length using ASCON-XOF.
+ *
+ * \param pre Pre-computed state to be initialized.
+ * \param custom Points to the customization string.
+ * \param customlen Number of bytes in the customization string.
+ * \param outlen The desired output length in bytes, or 0 for arbitrary-length.
+ *
+ * The pre-computed state can then be used with ascon_kmac_init_precomputed()
+ * to start new KMAC operations without re-absorbing the customization
+ * string each time.  It must be freed with ascon_xof_precomputed_free()
+ * when it is no longer required.
+ */
+void ascon_kmac_precompute
+    (ascon_xof_precomputed_t *pre, const unsigned char *custom,
+     size_t customlen, size_t outlen);
+
+/**
+ * \brief Initializes an incremental KMAC state using ASCON-XOF and
+ * a pre-computed customization state.
+ *
+ * \param state Points to the state to be initialized.
+ * \param pre Points to the pre-computed state from ascon_kmac_precompute().
+ * \param key Points to the key.
+ * \param keylen Number of bytes in the key.
+ *
+ * \sa ascon_kmac_precompute(), ascon_kmac_init()
+ */
+void ascon_kmac_init_precomputed
+    (ascon_kmac_state_t *state, const ascon_xof_precomputed_t *pre,
+     const unsigned char *key, size_t keylen);
+
+/**
+ * \brief Re-initializes an incremental KMAC state using ASCON-XOF and
+ * a pre-computed customization state.
+ *
+ * \param state Points to the state to be initialized.
+ * \param pre Points to the pre-computed state from ascon_kmac_precompute().
+ * \param key Points to the key.
+ * \param keylen Number of bytes in the key.
+ *
+ * This function is equivalent to calling ascon_kmac_free() and then
+ * ascon_kmac_init_precomputed().
+ *
+ * \sa ascon_kmac_init_precomputed()
+ */
+void ascon_kmac_reinit_precomputed
+    (ascon_kmac_state_t *state, const ascon_xof_precomputed_t *pre,
+     const unsigned char *key, size_t keylen);
+
+/**
+ * \brief Pre-computes an ASCON-KMAC key context for a fixed key,
+ * customization string, and output length.
+ *
+ * \param key Points to the key context to initialize.
+ * \param k Points to the key.
+ * \param keylen Number of bytes in the key.
+ * \param custom Points to the customization string.
+ * \param customlen Number of bytes in the customization string.
+ * \param outlen The desired output length in bytes, or 0 for arbitrary-length.
+ *
+ * The key context captures the ASCON-KMAC state after the customization
+ * string and key have been absorbed.  New messages can then be started
+ * with ascon_kmac_init_keyed() without absorbing the key again.
+ *
+ * \sa ascon_kmac_key_free(), ascon_kmac_init_keyed()
+ */
+void ascon_kmac_key_init
+    (ascon_kmac_key_t *key, const unsigned char *k, size_t keylen,
+     const unsigned char *custom, size_t customlen, size_t outlen);
+
+/**
+ * \brief Frees an ASCON-KMAC key context and destroys any sensitive
+ * material.
+ *
+ * \param key Points to the key context to free.
+ */
+void ascon_kmac_key_free(ascon_kmac_key_t *key);
+
+/**
+ * \brief Initializes an incremental ASCON-KMAC state from a key context.
+ *
+ * \param state Points to the state to be initialized.
+ * \param key Points to the key context.
+ *
+ * The \a key context is not modified and can be used to initialize
+ * any number of states.
+ *
+ * \sa ascon_kmac_key_init(), ascon_kmac_reinit_keyed()
+ */
+void ascon_kmac_init_keyed
+    (ascon_kmac_state_t *state, const ascon_kmac_key_t *key);
+
+/**
+ * \brief Re-initializes an incremental ASCON-KMAC state from a
+ * key context.
+ *
+ * \param state Points to the state to be re-initialized.
+ * \param key Points to the key context.
+ *
+ * This function is equivalent to calling ascon_kmac_free() and then
+ * ascon_kmac_init_keyed().  It is used to reset a state for the next
+ * message when the key stays the same.
+ *
+ * \sa ascon_kmac_init_keyed()
+ */
+void ascon_kmac_reinit_keyed
+    (ascon_kmac_state_t *state, const ascon_kmac_key_t *key);
+
+/**
+ * \brief Computes a KMAC value using ASCON-XOF and a key context.
+ *
+ * \param key Points to the key context.
+ * \param in Points to the data to authenticate.
+ * \param inlen Number of bytes of data to authenticate.
+ * \param out Buffer to receive the output KMAC value.
+ * \param outlen Length of the output KMAC value, which should be the
+ * same as the length that was supplied to ascon_kmac_key_init().
+ *
+ * \sa ascon_kmac(), ascon_kmac_key_init()
+ */
+void ascon_kmac_with_key
+    (const ascon_kmac_key_t *key, const unsigned char *in, size_t inlen,
+     unsigned char *out, size_t outlen);
+
 /**
  * \brief Frees the ASCON-KMAC state and destroys any sensitive material.
  *
@@ -218,6 +366,132 @@ void ascon_kmaca_reinit
     (ascon_kmaca_state_t *state, const unsigned char *key, size_t keylen,
      const unsigned char *custom, size_t customlen, size_t outlen);
 
+/**
+ * \brief Pre-computes the initial KMAC state for a customization string
+ * and output length using ASCON-XOFA.
+ *
+ * \param pre Pre-computed state to be initialized.
+ * \param custom Points to the customization string.
+ * \param customlen Number of bytes in the customization string.
+ * \param outlen The desired output length in bytes, or 0 for arbitrary-length.
+ *
+ * The pre-computed state can then be used with ascon_kmaca_init_precomputed()
+ * to start new KMAC operations without re-absorbing the customization
+ * string each time.  It must be freed with ascon_xofa_precomputed_free()
+ * when it is no longer required.
+ */
+void ascon_kmaca_precompute
+    (ascon_xofa_precomputed_t *pre, const unsigned char *custom,
+     size_t customlen, size_t outlen);
+
+/**
+ * \brief Initializes an incremental KMAC state using ASCON-XOFA and
+ * a pre-computed customization state.
+ *
+ * \param state Points to the state to be initialized.
+ * \param pre Points to the pre-computed state from ascon_kmaca_precompute().
+ * \param key Points to the key.
+ * \param keylen Number of bytes in the key.
+ *
+ * \sa ascon_kmaca_precompute(), ascon_kmaca_init()
+ */
+void ascon_kmaca_init_precomputed
+    (ascon_kmaca_state_t *state, const ascon_xofa_precomputed_t *pre,
+     const unsigned char *key, size_t keylen);
+
+/**
+ * \brief Re-initializes an incremental KMAC state using ASCON-XOFA and
+ * a pre-computed customization state.
+ *
+ * \param state Points to the state to be initialized.
+ * \param pre Points to the pre-computed state from ascon_kmaca_precompute().
+ * \param key Points to the key.
+ * \param keylen Number of bytes in the key.
+ *
+ * This function is equivalent to calling ascon_kmaca_free() and then
+ * ascon_kmaca_init_precomputed().
+ *
+ * \sa ascon_kmaca_init_precomputed()
+ */
+void ascon_kmaca_reinit_precomputed
+    (ascon_kmaca_state_t *state, const ascon_xofa_precomputed_t *pre,
+     const unsigned char *key, size_t keylen);
+
+/**
+ * \brief Pre-computes an ASCON-KMACA key context for a fixed key,
+ * customization string, and output length.
+ *
+ * \param key Points to the key context to initialize.
+ * \param k Points to the key.
+ * \param keylen Number of bytes in the key.
+ * \param custom Points to the customization string.
+ * \param customlen Number of bytes in the customization string.
+ * \param outlen The desired output length in bytes, or 0 for arbitrary-length.
+ *
+ * The key context captures the ASCON-KMACA state after the customization
+ * string and key have been absorbed.  New messages can then be started
+ * with ascon_kmaca_init_keyed() without absorbing the key again.
+ *
+ * \sa ascon_kmaca_key_free(), ascon_kmaca_init_keyed()
+ */
+void ascon_kmaca_key_init
+    (ascon_kmaca_key_t *key, const unsigned char *k, size_t keylen,
+     const unsigned char *custom, size_t customlen, size_t outlen);
+
+/**
+ * \brief Frees an ASCON-KMACA key context and destroys any sensitive
+ * material.
+ *
+ * \param key Points to the key context to free.
+ */
+void ascon_kmaca_key_free(ascon_kmaca_key_t *key);
+
+/**
+ * \brief Initializes an incremental ASCON-KMACA state from a key context.
+ *
+ * \param state Points to the state to be initialized.
+ * \param key Points to the key context.
+ *
+ * The \a key context is not modified and can be used to initialize
+ * any number of states.
+ *
+ * \sa ascon_kmaca_key_init(), ascon_kmaca_reinit_keyed()
+ */
+void ascon_kmaca_init_keyed
+    (ascon_kmaca_state_t *state, const ascon_kmaca_key_t *key);
+
+/**
+ * \brief Re-initializes an incremental ASCON-KMACA state from a
+ * key context.
+ *
+ * \param state Points to the state to be re-initialized.
+ * \param key Points to the key context.
+ *
+ * This function is equivalent to calling ascon_kmaca_free() and then
+ * ascon_kmaca_init_keyed().  It is used to reset a state for the next
+ * message when the key stays the same.
+ *
+ * \sa ascon_kmaca_init_keyed()
+ */
+void ascon_kmaca_reinit_keyed
+    (ascon_kmaca_state_t *state, const ascon_kmaca_key_t *key);
+
+/**
+ * \brief Computes a KMAC value using ASCON-XOFA and a key context.
+ *
+ * \param key Points to the key context.
+ * \param in Points to the data to authenticate.
+ * \param inlen Number of bytes of data to authenticate.
+ * \param out Buffer to receive the output KMAC value.
+ * \param outlen Length of the output KMAC value, which should be the
+ * same as the length that was supplied to ascon_kmaca_key_init().
+ *
+ * \sa ascon_kmaca(), ascon_kmaca_key_init()
+ */
+void ascon_kmaca_with_key
+    (const ascon_kmaca_key_t *key, const unsigned char *in, size_t inlen,
+     unsigned char *out, size_t outlen);
+
 /**
  * \brief Frees the ASCON-KMACA state and destroys any sensitive material.
  *
@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2023 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef ASCON_MERKLE_H
+#define ASCON_MERKLE_H
+
+/**
+ * \file merkle.h
+ * \brief Merkle hash trees based on ASCON-HASH and ASCON-HASHA.
+ *
+ * A Merkle tree summarises a large number of leaves with a single root
+ * hash.  Changing one leaf only requires the hashes on the path from
+ * that leaf to the root to be recomputed.  An inclusion proof for a
+ * leaf consists of the sibling hashes along that path.
+ *
+ * Leaves and interior nodes are hashed with a one-byte domain
+ * separation prefix to prevent second preimage attacks that confuse
+ * the two:
+ *
+ * \li Leaf = HASH(0x00 || data)
+ * \li Node = HASH(0x01 || left || right)
+ *
+ * The tree is stored in a contiguous array that is supplied by the
+ * caller, in the implicit "heap" order: the root is node 1 and the
+ * children of node i are nodes 2i and 2i + 1.  The number of leaves
+ * is fixed at a power of two when the tree is initialized.  Leaves that
+ * have not been set yet have an all-zeroes hash value.
+ */
+
+#include <ascon/hash.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Size of a node hash in a Merkle tree.
+ */
+#define ASCON_MERKLE_HASH_SIZE ASCON_HASH_SIZE
+
+/**
+ * \brief Number of bytes that are required for the node array of a
+ * Merkle tree with a specific number of leaves.
+ *
+ * \param capacity Number of leaves in the tree, which must be a power of two.
+ */
+#define ASCON_MERKLE_NODES_SIZE(capacity) \
+    ((capacity) * 2 * ASCON_MERKLE_HASH_SIZE)
+
+/**
+ * \brief State information for a Merkle tree.
+ */
+typedef struct
+{
+    unsigned char *nodes;   /**< Node array, 2 * capacity hashes in size */
+    size_t capacity;        /**< Number of leaves in the tree */
+    unsigned depth;         /**< Number of levels below the root */
+    unsigned char hasha;    /**< Non-zero if the tree uses ASCON-HASHA */
+
+} ascon_merkle_tree_t;
+
+/**
+ * \brief Initializes an empty Merkle tree that uses ASCON-HASH.
+ *
+ * \param tree The tree to initialize.
+ * \param nodes Points to the array to use to store the node hashes,
+ * which must be at least ASCON_MERKLE_NODES_SIZE(\a capacity) bytes
+ * in size.
+ * \param capacity The number of leaves in the tree, which must be a
+ * non-zero power of two.
+ *
+ * \return Zero on success or -1 if \a capacity is not a power of two.
+ *
+ * \sa ascon_merkle_init_hasha()
+ */
+int ascon_merkle_init
+    (ascon_merkle_tree_t *tree, unsigned char *nodes, size_t capacity);
+
+/**
+ * \brief Initializes an empty Merkle tree that uses ASCON-HASHA.
+ *
+ * \param tree The tree to initialize.
+ * \param nodes Points to the array to use to store the node hashes,
+ * which must be at least ASCON_MERKLE_NODES_SIZE(\a capacity) bytes
+ * in size.
+ * \param capacity The number of leaves in the tree, which must be a
+ * non-zero power of two.
+ *
+ * \return Zero on success or -1 if \a capacity is not a power of two.
+ *
+ * \sa ascon_merkle_init()
+ */
+int ascon_merkle_init_hasha
+    (ascon_merkle_tree_t *tree, unsigned char *nodes, size_t capacity);
+
+/**
+ * \brief Gets the root hash of a Merkle tree.
+ *
+ * \param tree The tree.
+ *
+ * \return A pointer to the ASCON_MERKLE_HASH_SIZE bytes of the root hash
+ * within the node array.
+ */
+const unsigned char *ascon_merkle_root(const ascon_merkle_tree_t *tree);
+
+/**
+ * \brief Sets the data for a leaf in a Merkle tree and updates the
+ * hashes on the path to the root.
+ *
+ * \param tree The tree to update.
+ * \param index Index of the leaf between 0 and capacity - 1.
+ * \param data Points to the data for the leaf.
+ * \param len Length of the leaf data in bytes.
+ *
+ * \return Zero on success or -1 if \a index is out of range.
+ *
+ * \sa ascon_merkle_set_leaves()
+ */
+int ascon_merkle_set_leaf
+    (ascon_merkle_tree_t *tree, size_t index,
+     const unsigned char *data, size_t len);
+
+/**
+ * \brief Sets the data for a batch of leaves in a Merkle tree and
+ * updates the interior hashes.
+ *
+ * \param tree The tree to update.
+ * \param indices Points to an array of leaf indices, which must be in
+ * strictly ascending order.
+ * \param data Points to an array of pointers to the leaf data.
+ * \param lens Points to an array of leaf data lengths.
+ * \param count Number of leaves to update.
+ *
+ * \return Zero on success or -1 if the indices are out of range or not
+ * in strictly ascending order.  The tree is not modified on error.
+ *
+ * Ancestors that are shared between the updated leaves are only
+ * rehashed once, so this is cheaper than calling ascon_merkle_set_leaf()
+ * for each leaf when the leaves are close together.
+ */
+int ascon_merkle_set_leaves
+    (ascon_merkle_tree_t *tree, const size_t *indices,
+     const unsigned char * const *data, const size_t *lens, size_t count);
+
+/**
+ * \brief Gets the inclusion proof for a leaf in a Merkle tree.
+ *
+ * \param tree The tree.
+ * \param index Index of the leaf between 0 and capacity - 1.
+ * \param proof Points to the buffer to receive the proof, which must be
+ * at least depth * ASCON_MERKLE_HASH_SIZE bytes in size.
+ *
+ * \return Zero on success or -1 if \a index is out of range.
+ *
+ * The proof consists of the sibling hashes on the path from the leaf
+ * to the root, starting with the leaf's sibling.
+ *
+ * \sa ascon_merkle_verify()
+ */
+int ascon_merkle_get_proof
+    (const ascon_merkle_tree_t *tree, size_t index, unsigned char *proof);
+
+/**
+ * \brief Verifies an inclusion proof for a leaf in an ASCON-HASH
+ * Merkle tree.
+ *
+ * \param root Points to the expected root hash.
+ * \param index Index of the leaf in the tree.
+ * \param depth Depth of the tree, which is the number of hashes
+ * in the \a proof.
+ * \param data Points to the data for the leaf.
+ * \param len Length of the leaf data in bytes.
+ * \param proof Points to the proof from ascon_merkle_get_proof().
+ *
+ * \return Zero if the proof is valid or -1 if it is not.
+ *
+ * \sa ascon_merkle_get_proof(), ascon_merkle_verify_hasha()
+ */
+int ascon_merkle_verify
+    (const unsigned char *root, size_t index, unsigned depth,
+     const unsigned char *data, size_t len, const unsigned char *proof);
+
+/**
+ * \brief Verifies an inclusion proof for a leaf in an ASCON-HASHA
+ * Merkle tree.
+ *
+ * \param root Points to the expected root hash.
+ * \param index Index of the leaf in the tree.
+ * \param depth Depth of the tree, which is the number of hashes
+ * in the \a proof.
+ * \param data Points to the data for the leaf.
+ * \param len Length of the leaf data in bytes.
+ * \param proof Points to the proof from ascon_merkle_get_proof().
+ *
+ * \return Zero if the proof is valid or -1 if it is not.
+ *
+ * \sa ascon_merkle_get_proof(), ascon_merkle_verify()
+ */
+int ascon_merkle_verify_hasha
+    (const unsigned char *root, size_t index, unsigned depth,
+     const unsigned char *data, size_t len, const unsigned char *proof);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2023 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef ASCON_MULTI_HASH_H
+#define ASCON_MULTI_HASH_H
+
+/**
+ * \file multi-hash.h
+ * \brief Computing several ASCON hash digests over the same input.
+ *
+ * The multi-hash API absorbs a single stream of input data into any
+ * combination of ASCON-HASH, ASCON-HASHA, ASCON-XOF, and ASCON-XOFA
+ * at the same time.  Each block of input is absorbed into all of the
+ * selected states while it is still in the cache, so the input only
+ * needs to be read once.
+ *
+ * \code
+ * ascon_multi_hash_state_t state;
+ * unsigned char hash[ASCON_HASH_SIZE];
+ * unsigned char hasha[ASCON_HASHA_SIZE];
+ *
+ * ascon_multi_hash_init(&state, ASCON_MULTI_HASH | ASCON_MULTI_HASHA);
+ * ascon_multi_hash_update(&state, data, data_len);
+ * ascon_multi_hash_finalize_hash(&state, hash);
+ * ascon_multi_hash_finalize_hasha(&state, hasha);
+ * ascon_multi_hash_free(&state);
+ * \endcode
+ */
+
+#include <ascon/hash.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Selects ASCON-HASH in a multi-hash state.
+ */
+#define ASCON_MULTI_HASH 0x01
+
+/**
+ * \brief Selects ASCON-HASHA in a multi-hash state.
+ */
+#define ASCON_MULTI_HASHA 0x02
+
+/**
+ * \brief Selects ASCON-XOF with arbitrary-length output in a
+ * multi-hash state.
+ */
+#define ASCON_MULTI_XOF 0x04
+
+/**
+ * \brief Selects ASCON-XOFA with arbitrary-length output in a
+ * multi-hash state.
+ */
+#define ASCON_MULTI_XOFA 0x08
+
+/**
+ * \brief State information for hashing the same input with several
+ * ASCON hash algorithms at once.
+ */
+typedef struct
+{
+    ascon_hash_state_t hash;    /**< ASCON-HASH state */
+    ascon_hasha_state_t hasha;  /**< ASCON-HASHA state */
+    ascon_xof_state_t xof;      /**< ASCON-XOF state */
+    ascon_xofa_state_t xofa;    /**< ASCON-XOFA state */
+    unsigned char algorithms;   /**< Bit mask of the selected algorithms */
+    unsigned char count;        /**< Number of bytes in the current block */
+
+} ascon_multi_hash_state_t;
+
+/**
+ * \brief Initializes a multi-hash state.
+ *
+ * \param state Multi-hash state to be initialized.
+ * \param algorithms Bit mask of the algorithms to compute; e.g.
+ * ASCON_MULTI_HASH | ASCON_MULTI_HASHA.
+ *
+ * \sa ascon_multi_hash_update()
+ */
+void ascon_multi_hash_init
+    (ascon_multi_hash_state_t *state, unsigned algorithms);
+
+/**
+ * \brief Frees a multi-hash state and destroys any sensitive material.
+ *
+ * \param state Multi-hash state to be freed.
+ */
+void ascon_multi_hash_free(ascon_multi_hash_state_t *state);
+
+/**
+ * \brief Updates all of the selected algorithms in a multi-hash state
+ * with more input data.
+ *
+ * \param state Multi-hash state to be updated.
+ * \param in Points to the input data to be absorbed into the state.
+ * \param inlen Length of the input data to be absorbed into the state.
+ *
+ * This function must not be called once any of the finalize or
+ * squeeze functions have been called.
+ */
+void ascon_multi_hash_update
+    (ascon_multi_hash_state_t *state, const unsigned char *in, size_t inlen);
+
+/**
+ * \brief Returns the ASCON-HASH value from a multi-hash state.
+ *
+ * \param state Multi-hash state.
+ * \param out Points to the output buffer to receive the hash value,
+ * which must be at least ASCON_HASH_SIZE bytes in length.
+ *
+ * The result is undefined if ASCON_MULTI_HASH was not selected.
+ */
+void ascon_multi_hash_finalize_hash
+    (ascon_multi_hash_state_t *state, unsigned char *out);
+
+/**
+ * \brief Returns the ASCON-HASHA value from a multi-hash state.
+ *
+ * \param state Multi-hash state.
+ * \param out Points to the output buffer to receive the hash value,
+ * which must be at least ASCON_HASHA_SIZE bytes in length.
+ *
+ * The result is undefined if ASCON_MULTI_HASHA was not selected.
+ */
+void ascon_multi_hash_finalize_hasha
+    (ascon_multi_hash_state_t *state, unsigned char *out);
+
+/**
+ * \brief Squeezes ASCON-XOF output data from a multi-hash state.
+ *
+ * \param state Multi-hash state.
+ * \param out Points to the output buffer to receive the squeezed data.
+ * \param outlen Number of bytes of data to squeeze out of the state.
+ *
+ * This may be called multiple times to squeeze more output.
+ * The result is undefined if ASCON_MULTI_XOF was not selected.
+ */
+void ascon_multi_hash_squeeze_xof
+    (ascon_multi_hash_state_t *state, unsigned char *out, size_t outlen);
+
+/**
+ * \brief Squeezes ASCON-XOFA output data from a multi-hash state.
+ *
+ * \param state Multi-hash state.
+ * \param out Points to the output buffer to receive the squeezed data.
+ * \param outlen Number of bytes of data to squeeze out of the state.
+ *
+ * This may be called multiple times to squeeze more output.
+ * The result is undefined if ASCON_MULTI_XOFA was not selected.
+ */
+void ascon_multi_hash_squeeze_xofa
+    (ascon_multi_hash_state_t *state, unsigned char *out, size_t outlen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -23,6 +23,7 @@
 #ifndef ASCON_PBKDF2_H
 #define ASCON_PBKDF2_H
 
+#include <ascon/storage.h>
 #include <stddef.h>
 
 /**
@@ -42,6 +43,22 @@ extern "C" {
  */
 #define ASCON_PBKDF2_SIZE 32
 
+/**
+ * \brief Calibrate the iteration count for ascon_pbkdf2().
+ */
+#define ASCON_PBKDF2_CALIBRATE_XOF 0
+
+/**
+ * \brief Calibrate the iteration count for ascon_pbkdf2_hmac().
+ */
+#define ASCON_PBKDF2_CALIBRATE_HMAC 1
+
+/**
+ * \brief Size of a calibration result that has been saved in
+ * non-volatile storage.
+ */
+#define ASCON_PBKDF2_CALIBRATION_SIZE 16
+
 /**
  * \brief Derives key material using ASCON-PBKDF2.
  *
@@ -70,6 +87,35 @@ void ascon_pbkdf2
      const unsigned char *password, size_t passwordlen,
      const unsigned char *salt, size_t saltlen, unsigned long count);
 
+/**
+ * \brief Derives key material for a batch of passwords using ASCON-PBKDF2.
+ *
+ * \param out Array of \a num pointers to the output buffers to receive
+ * the key material.
+ * \param outlen Number of bytes of key material to generate for each
+ * password.
+ * \param password Array of \a num pointers to the password bytes.
+ * \param passwordlen Array of \a num password lengths.
+ * \param salt Array of \a num pointers to the salt bytes.
+ * \param saltlen Array of \a num salt lengths.
+ * \param num Number of passwords in the batch.
+ * \param count Number of iterations to perform for every password.
+ * If this is set to zero, then the value will be changed to 1.
+ *
+ * The result is the same as calling ascon_pbkdf2() on each password
+ * and salt pair.  Passwords are processed two at a time with their
+ * iteration chains advanced in lockstep.  On platforms that support it,
+ * the permutation calls for the two chains are interleaved, which makes
+ * better use of the CPU than processing the passwords one by one.
+ *
+ * \sa ascon_pbkdf2()
+ */
+void ascon_pbkdf2_batch
+    (unsigned char *const *out, size_t outlen,
+     const unsigned char *const *password, const size_t *passwordlen,
+     const unsigned char *const *salt, const size_t *saltlen,
+     size_t num, unsigned long count);
+
 /**
  * \brief Derives key material using ASCON-PBKDF2 (legacy HMAC version).
  *
@@ -95,6 +141,57 @@ void ascon_pbkdf2_hmac
      const unsigned char *password, size_t passwordlen,
      const unsigned char *salt, size_t saltlen, unsigned long count);
 
+/**
+ * \brief Calibrates the PBKDF2 iteration count for the current machine.
+ *
+ * \param target_ms Target time for deriving a key, in milliseconds.
+ * \param variant Either ASCON_PBKDF2_CALIBRATE_XOF to calibrate for
+ * ascon_pbkdf2() or ASCON_PBKDF2_CALIBRATE_HMAC to calibrate for
+ * ascon_pbkdf2_hmac().
+ *
+ * \return The iteration count that will take approximately \a target_ms
+ * milliseconds to derive ASCON_PBKDF2_SIZE bytes of key material, or
+ * zero if there is no usable high resolution timer on this platform.
+ *
+ * This function measures the speed of the selected PBKDF2 variant with
+ * the permutation backend that the library was compiled with.  It will
+ * run for a fraction of \a target_ms before returning.  The measurement
+ * uses CPU time for the calling thread where possible, so the result
+ * does not depend upon the load from other processes.
+ *
+ * Generating more than ASCON_PBKDF2_SIZE bytes of key material with the
+ * returned count will take longer than \a target_ms.
+ *
+ * \sa ascon_pbkdf2_calibrate_stored()
+ */
+unsigned long ascon_pbkdf2_calibrate(unsigned long target_ms, int variant);
+
+/**
+ * \brief Calibrates the PBKDF2 iteration count for the current machine
+ * and persists the result in non-volatile storage.
+ *
+ * \param target_ms Target time for deriving a key, in milliseconds.
+ * \param variant Either ASCON_PBKDF2_CALIBRATE_XOF or
+ * ASCON_PBKDF2_CALIBRATE_HMAC.
+ * \param storage The non-volatile storage region to load and save the
+ * calibration result from.  The result is stored at offset zero
+ * within the region.
+ *
+ * \return The iteration count, or zero if no result was stored and
+ * there is no usable high resolution timer on this platform.
+ *
+ * If \a storage contains a previous result for the same \a target_ms
+ * and \a variant, then that result is returned without measuring again.
+ * Otherwise ascon_pbkdf2_calibrate() is called and the new result is
+ * saved into \a storage.  To force a new measurement, for example after
+ * moving to new hardware, erase the storage region first.
+ *
+ * The calibration result in non-volatile storage is
+ * ASCON_PBKDF2_CALIBRATION_SIZE bytes in size.
+ */
+unsigned long ascon_pbkdf2_calibrate_stored
+    (unsigned long target_ms, int variant, const ascon_storage_t *storage);
+
 #ifdef __cplusplus
 }
 #endif
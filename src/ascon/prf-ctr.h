@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef ASCON_PRF_CTR_H
+#define ASCON_PRF_CTR_H
+
+/**
+ * \file prf-ctr.h
+ * \brief Random-access keystream generation with ASCON-Prf in counter mode.
+ *
+ * The sequential duplex constructions in the AEAD and SIV modes cannot
+ * seek to an arbitrary position in the keystream.  This module generates
+ * the keystream in blocks of ASCON_PRF_CTR_BLOCK_SIZE bytes, where block
+ * i is the ASCON-Prf output for the nonce followed by i:
+ *
+ * \code
+ * block[i] = ascon_prf_fixed(ASCON_PRF_CTR_BLOCK_SIZE, nonce || BE64(i), key)
+ * \endcode
+ *
+ * Any byte range can therefore be generated independently, in any order.
+ * The functions ascon_prf_ctr_blocks() and ascon_prf_ctr_xor_at() do not
+ * modify the state, so several threads can share one state and each
+ * encrypt or decrypt a different region of a large file.
+ *
+ * This is an unauthenticated stream cipher.  The nonce must never be
+ * reused with the same key, and the ciphertext should be protected by
+ * a MAC if an attacker can modify it.
+ *
+ * \code
+ * ascon_prf_ctr_state_t state;
+ * ascon_prf_ctr_init(&state, key, nonce);
+ * ascon_prf_ctr_seek(&state, offset);
+ * ascon_prf_ctr_xor(&state, buf, buf, len);
+ * ascon_prf_ctr_free(&state);
+ * \endcode
+ */
+
+#include <ascon/prf.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Size of the nonce for ASCON-Prf counter mode.
+ */
+#define ASCON_PRF_CTR_NONCE_SIZE 16
+
+/**
+ * \brief Size of each keystream block for ASCON-Prf counter mode.
+ */
+#define ASCON_PRF_CTR_BLOCK_SIZE 64
+
+/**
+ * \brief State information for ASCON-Prf counter mode.
+ *
+ * This structure should be treated as opaque.
+ */
+typedef struct
+{
+    ascon_prf_key_t key;    /**< Pre-computed key context */
+    unsigned char nonce[ASCON_PRF_CTR_NONCE_SIZE]; /**< Nonce */
+    uint64_t offset;        /**< Current position in the keystream */
+    uint64_t block;         /**< Index of the block in the buffer */
+    unsigned char buffer[ASCON_PRF_CTR_BLOCK_SIZE]; /**< Buffered block */
+    unsigned char buffered; /**< Non-zero if the buffer is valid */
+
+} ascon_prf_ctr_state_t;
+
+/**
+ * \brief Initializes the state for ASCON-Prf counter mode.
+ *
+ * \param state The state to initialize.
+ * \param key Points to the ASCON_PRF_KEY_SIZE bytes of the key.
+ * \param nonce Points to the ASCON_PRF_CTR_NONCE_SIZE bytes of the nonce.
+ *
+ * The position in the keystream starts at zero.
+ *
+ * \sa ascon_prf_ctr_free(), ascon_prf_ctr_seek()
+ */
+void ascon_prf_ctr_init
+    (ascon_prf_ctr_state_t *state, const unsigned char *key,
+     const unsigned char *nonce);
+
+/**
+ * \brief Frees the state for ASCON-Prf counter mode and destroys any
+ * sensitive material.
+ *
+ * \param state The state to free.
+ */
+void ascon_prf_ctr_free(ascon_prf_ctr_state_t *state);
+
+/**
+ * \brief Seeks to a new position in the keystream.
+ *
+ * \param state The ASCON-Prf counter mode state.
+ * \param offset The byte offset of the new position.
+ *
+ * This takes constant time regardless of the distance moved.
+ *
+ * \sa ascon_prf_ctr_tell()
+ */
+void ascon_prf_ctr_seek(ascon_prf_ctr_state_t *state, uint64_t offset);
+
+/**
+ * \brief Gets the current position in the keystream.
+ *
+ * \param state The ASCON-Prf counter mode state.
+ *
+ * \return The byte offset of the current position.
+ *
+ * \sa ascon_prf_ctr_seek()
+ */
+uint64_t ascon_prf_ctr_tell(const ascon_prf_ctr_state_t *state);
+
+/**
+ * \brief Generates keystream bytes at the current position.
+ *
+ * \param state The ASCON-Prf counter mode state.
+ * \param out Points to the buffer to receive the keystream.
+ * \param outlen Number of bytes of keystream to generate.
+ *
+ * The position is advanced by \a outlen bytes.
+ */
+void ascon_prf_ctr_keystream
+    (ascon_prf_ctr_state_t *state, unsigned char *out, size_t outlen);
+
+/**
+ * \brief Encrypts or decrypts data at the current position.
+ *
+ * \param state The ASCON-Prf counter mode state.
+ * \param out Points to the output buffer.
+ * \param in Points to the input buffer.  This may be the same as \a out.
+ * \param len Number of bytes to encrypt or decrypt.
+ *
+ * The input is XOR'ed with the keystream and the position is advanced
+ * by \a len bytes.  Encryption and decryption are the same operation.
+ */
+void ascon_prf_ctr_xor
+    (ascon_prf_ctr_state_t *state, unsigned char *out,
+     const unsigned char *in, size_t len);
+
+/**
+ * \brief Generates multiple whole keystream blocks.
+ *
+ * \param state The ASCON-Prf counter mode state.
+ * \param out Points to the buffer to receive the keystream, which must
+ * be \a num_blocks * ASCON_PRF_CTR_BLOCK_SIZE bytes in length.
+ * \param first_block Index of the first block to generate.
+ * \param num_blocks Number of blocks to generate.
+ *
+ * The blocks are independent of each other so on some platforms they
+ * are generated two at a time with interleaved permutation calls.
+ * The state and its current position are not modified.
+ */
+void ascon_prf_ctr_blocks
+    (const ascon_prf_ctr_state_t *state, unsigned char *out,
+     uint64_t first_block, size_t num_blocks);
+
+/**
+ * \brief Encrypts or decrypts data at an explicit position.
+ *
+ * \param state The ASCON-Prf counter mode state.
+ * \param out Points to the output buffer.
+ * \param in Points to the input buffer.  This may be the same as \a out.
+ * \param len Number of bytes to encrypt or decrypt.
+ * \param offset Byte offset of the data within the keystream.
+ *
+ * The state and its current position are not modified, so multiple
+ * threads may call this function on the same state at once to process
+ * different regions of the same file.
+ */
+void ascon_prf_ctr_xor_at
+    (const ascon_prf_ctr_state_t *state, unsigned char *out,
+     const unsigned char *in, size_t len, uint64_t offset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -112,6 +112,17 @@ typedef struct
 
 } ascon_prf_state_t;
 
+/**
+ * \brief Pre-computed key context for ASCON-Prf and ASCON-Mac.
+ *
+ * This structure should be treated as opaque.
+ */
+typedef struct
+{
+    ascon_prf_state_t prf;  /**< ASCON-Prf state after absorbing the key */
+
+} ascon_prf_key_t;
+
 /**
  * \brief Processes a key and input data with ASCON-Prf to produce a tag.
  *
@@ -212,6 +223,31 @@ int ascon_mac_verify
      const unsigned char *in, size_t inlen,
      const unsigned char *key);
 
+/**
+ * \brief Verifies a batch of ASCON-Mac tag values.
+ *
+ * \param results Bitmap to receive the results, which must be at least
+ * (\a count + 7) / 8 bytes in length.  Bit (i % 8) of byte (i / 8) is
+ * set to 1 if tag i is correct, or 0 if tag i is incorrect.
+ * \param tag Array of \a count pointers to the ASCON_MAC_TAG_SIZE byte tags.
+ * \param in Array of \a count pointers to the data to authenticate.
+ * \param inlen Array of \a count data lengths.
+ * \param key Array of \a count pointers to the ASCON_MAC_KEY_SIZE byte keys.
+ * \param count Number of items in the batch.
+ *
+ * \return 0 if all tags are correct, or -1 if at least one is incorrect.
+ *
+ * Each tag is checked in constant time.  On platforms that support it,
+ * the tags are computed two at a time with the permutation calls for
+ * the two items interleaved.
+ *
+ * \sa ascon_mac_verify()
+ */
+int ascon_mac_verify_batch
+    (unsigned char *results, const unsigned char *const *tag,
+     const unsigned char *const *in, const size_t *inlen,
+     const unsigned char *const *key, size_t count);
+
 /**
  * \brief Initializes the state for an incremental ASCON-Prf operation.
  *
@@ -302,6 +338,117 @@ void ascon_prf_absorb
 void ascon_prf_squeeze
     (ascon_prf_state_t *state, unsigned char *out, size_t outlen);
 
+/**
+ * \brief Pre-computes an ASCON-Prf key context for a fixed key.
+ *
+ * \param key Points to the key context to initialize.
+ * \param k Points to the ASCON_PRF_KEY_SIZE bytes of the key.
+ * \param outlen Number of bytes of output that is desired, or 0 for
+ * unlimited output.  Set this to ASCON_MAC_TAG_SIZE to use the key
+ * context with ascon_mac_with_key().
+ *
+ * The key context captures the ASCON-Prf state after the initial
+ * permutation call that absorbs the key.  New messages can then be
+ * started with ascon_prf_init_keyed() without starting from scratch.
+ *
+ * \sa ascon_prf_key_free(), ascon_prf_init_keyed()
+ */
+void ascon_prf_key_init
+    (ascon_prf_key_t *key, const unsigned char *k, size_t outlen);
+
+/**
+ * \brief Frees an ASCON-Prf key context and destroys any sensitive material.
+ *
+ * \param key Points to the key context to free.
+ */
+void ascon_prf_key_free(ascon_prf_key_t *key);
+
+/**
+ * \brief Initializes the state for an incremental ASCON-Prf operation
+ * from a key context.
+ *
+ * \param state PRF state to be initialized.
+ * \param key Points to the key context.
+ *
+ * The \a key context is not modified and can be used to initialize
+ * any number of states.
+ *
+ * \sa ascon_prf_key_init(), ascon_prf_reinit_keyed()
+ */
+void ascon_prf_init_keyed
+    (ascon_prf_state_t *state, const ascon_prf_key_t *key);
+
+/**
+ * \brief Re-initializes the state for an incremental ASCON-Prf operation
+ * from a key context.
+ *
+ * \param state PRF state to be re-initialized.
+ * \param key Points to the key context.
+ *
+ * This function is equivalent to calling ascon_prf_free() and then
+ * ascon_prf_init_keyed().  It is used to reset a state for the next
+ * message when the key stays the same.
+ *
+ * \sa ascon_prf_init_keyed()
+ */
+void ascon_prf_reinit_keyed
+    (ascon_prf_state_t *state, const ascon_prf_key_t *key);
+
+/**
+ * \brief Processes input data with ASCON-Prf and a key context to
+ * produce a tag.
+ *
+ * \param out Buffer to receive the PRF tag which must be at least
+ * \a outlen bytes in length.
+ * \param outlen Length of the output buffer in bytes.  If the key context
+ * was initialized for fixed-length output, then this should be the same
+ * as the length that was supplied to ascon_prf_key_init().
+ * \param in Points to the input data to be processed.
+ * \param inlen Length of the input data in bytes.
+ * \param key Points to the key context.
+ *
+ * \sa ascon_prf(), ascon_prf_fixed(), ascon_prf_key_init()
+ */
+void ascon_prf_with_key
+    (unsigned char *out, size_t outlen,
+     const unsigned char *in, size_t inlen,
+     const ascon_prf_key_t *key);
+
+/**
+ * \brief Processes input data with ASCON-Mac and a key context to
+ * produce a tag.
+ *
+ * \param tag Buffer to receive the ASCON_MAC_TAG_SIZE bytes of the tag.
+ * \param in Points to the input data to be processed.
+ * \param inlen Length of the input data in bytes.
+ * \param key Points to the key context, which must have been initialized
+ * with an output length of ASCON_MAC_TAG_SIZE.
+ *
+ * \sa ascon_mac(), ascon_mac_verify_with_key()
+ */
+void ascon_mac_with_key
+    (unsigned char *tag,
+     const unsigned char *in, size_t inlen,
+     const ascon_prf_key_t *key);
+
+/**
+ * \brief Verifies an ASCON-Mac tag value using a key context.
+ *
+ * \param tag Buffer that contains the ASCON_MAC_TAG_SIZE bytes of the tag.
+ * \param in Points to the input data to be processed.
+ * \param inlen Length of the input data in bytes.
+ * \param key Points to the key context, which must have been initialized
+ * with an output length of ASCON_MAC_TAG_SIZE.
+ *
+ * \return 0 if the \a tag is correct or -1 if incorrect.
+ *
+ * \sa ascon_mac_verify(), ascon_mac_with_key()
+ */
+int ascon_mac_verify_with_key
+    (const unsigned char *tag,
+     const unsigned char *in, size_t inlen,
+     const ascon_prf_key_t *key);
+
 #ifdef __cplusplus
 }
 #endif
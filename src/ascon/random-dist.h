@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef ASCON_RANDOM_DIST_H
+#define ASCON_RANDOM_DIST_H
+
+#include <ascon/random.h>
+
+/**
+ * \file random-dist.h
+ * \brief Random integers, ranges, floating-point values, and shuffling.
+ *
+ * These functions draw their randomness from a buffered SpongePRNG,
+ * ascon_random_pool_t, so that producing a single integer does not
+ * require re-keying the generator.  The "fill" functions squeeze the
+ * XOF in large chunks directly into the caller's array.
+ *
+ * Bounded integers use Lemire's nearly division-free method, which
+ * is unbiased and only needs a division when a rejection is possible.
+ *
+ * Reference: "Fast Random Integer Generation in an Interval",
+ * Daniel Lemire, https://arxiv.org/abs/1805.10941
+ *
+ * All values are decoded in little-endian byte order so that the
+ * same seed produces the same sequence on every platform.
+ *
+ * \code
+ * ascon_random_pool_t pool;
+ * ascon_random_pool_init(&pool);
+ * die = ascon_random_pool_range(&pool, 6) + 1;
+ * ascon_random_pool_shuffle(&pool, cards, 52, sizeof(cards[0]));
+ * ascon_random_pool_free(&pool);
+ * \endcode
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Generates a uniformly distributed 32-bit integer.
+ *
+ * \param pool The buffered pseudorandom number generator to use.
+ *
+ * \return The random integer.
+ */
+uint32_t ascon_random_pool_uint32(ascon_random_pool_t *pool);
+
+/**
+ * \brief Generates a uniformly distributed 64-bit integer.
+ *
+ * \param pool The buffered pseudorandom number generator to use.
+ *
+ * \return The random integer.
+ */
+uint64_t ascon_random_pool_uint64(ascon_random_pool_t *pool);
+
+/**
+ * \brief Generates a uniformly distributed integer between 0 and n - 1.
+ *
+ * \param pool The buffered pseudorandom number generator to use.
+ * \param n The size of the range.
+ *
+ * \return The random integer, or 0 if \a n is zero.
+ *
+ * \sa ascon_random_pool_range64(), ascon_random_pool_fill_range()
+ */
+uint32_t ascon_random_pool_range(ascon_random_pool_t *pool, uint32_t n);
+
+/**
+ * \brief Generates a uniformly distributed 64-bit integer between
+ * 0 and n - 1.
+ *
+ * \param pool The buffered pseudorandom number generator to use.
+ * \param n The size of the range.
+ *
+ * \return The random integer, or 0 if \a n is zero.
+ *
+ * \sa ascon_random_pool_range()
+ */
+uint64_t ascon_random_pool_range64(ascon_random_pool_t *pool, uint64_t n);
+
+/**
+ * \brief Generates a uniformly distributed double-precision value
+ * between 0 and 1.
+ *
+ * \param pool The buffered pseudorandom number generator to use.
+ *
+ * \return A multiple of 2^-53 that is greater than or equal to 0
+ * and less than 1.
+ */
+double ascon_random_pool_double(ascon_random_pool_t *pool);
+
+/**
+ * \brief Generates a uniformly distributed single-precision value
+ * between 0 and 1.
+ *
+ * \param pool The buffered pseudorandom number generator to use.
+ *
+ * \return A multiple of 2^-24 that is greater than or equal to 0
+ * and less than 1.
+ */
+float ascon_random_pool_float(ascon_random_pool_t *pool);
+
+/**
+ * \brief Fills an array with uniformly distributed 32-bit integers.
+ *
+ * \param pool The buffered pseudorandom number generator to use.
+ * \param out Points to the array to fill.
+ * \param count Number of integers to generate.
+ */
+void ascon_random_pool_fill_uint32
+    (ascon_random_pool_t *pool, uint32_t *out, size_t count);
+
+/**
+ * \brief Fills an array with uniformly distributed integers between
+ * 0 and n - 1.
+ *
+ * \param pool The buffered pseudorandom number generator to use.
+ * \param out Points to the array to fill.
+ * \param count Number of integers to generate.
+ * \param n The size of the range.  If this is zero, then the array
+ * will be filled with zeroes.
+ */
+void ascon_random_pool_fill_range
+    (ascon_random_pool_t *pool, uint32_t *out, size_t count, uint32_t n);
+
+/**
+ * \brief Fills an array with uniformly distributed double-precision
+ * values between 0 and 1.
+ *
+ * \param pool The buffered pseudorandom number generator to use.
+ * \param out Points to the array to fill.
+ * \param count Number of values to generate.
+ *
+ * \sa ascon_random_pool_double()
+ */
+void ascon_random_pool_fill_double
+    (ascon_random_pool_t *pool, double *out, size_t count);
+
+/**
+ * \brief Shuffles an array into a uniformly random order.
+ *
+ * \param pool The buffered pseudorandom number generator to use.
+ * \param array Points to the array to shuffle.
+ * \param count Number of elements in the array.
+ * \param size Size of each element in bytes.
+ *
+ * This uses the Fisher-Yates shuffle, with the indices generated by
+ * ascon_random_pool_range() or ascon_random_pool_range64().
+ */
+void ascon_random_pool_shuffle
+    (ascon_random_pool_t *pool, void *array, size_t count, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
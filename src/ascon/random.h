@@ -59,11 +59,71 @@ typedef struct
     /** Number of bytes that have been generated since the last re-seed */
     uint32_t counter;
 
-    /** Padding to a 64-bit word boundary.  Reseved for future use */
-    uint32_t reserved;
+    /** Flags that modify the behaviour of the generator */
+    uint32_t flags;
 
 } ascon_random_state_t;
 
+/**
+ * \brief Size of the output pool for a buffered pseudorandom number
+ * generator.
+ */
+#define ASCON_RANDOM_POOL_SIZE 256
+
+/**
+ * \brief State information for a buffered pseudorandom number generator.
+ *
+ * The application should treat this structure as opaque.
+ */
+typedef struct
+{
+    /** Underlying pseudorandom number generator */
+    ascon_random_state_t prng;
+
+    /** Pool of output that has been squeezed but not yet returned */
+    unsigned char pool[ASCON_RANDOM_POOL_SIZE];
+
+    /** Number of bytes at the start of the pool that have been used */
+    unsigned posn;
+
+} ascon_random_pool_t;
+
+/**
+ * \brief Instrumentation counters for the random number sources.
+ *
+ * \sa ascon_random_get_stats()
+ */
+typedef struct
+{
+    /** Number of requests for seed material from the system TRNG */
+    uint64_t trng_requests;
+
+    /** Number of bytes of seed material drawn from the system TRNG */
+    uint64_t trng_bytes;
+
+    /** Number of calls into the operating system kernel to get seed
+     *  material, including retries.  This is zero on platforms where the
+     *  TRNG is a hardware peripheral that is accessed directly. */
+    uint64_t trng_syscalls;
+
+    /** Number of times that a pseudorandom number generator was
+     *  re-seeded from the system TRNG for any reason */
+    uint64_t reseeds;
+
+    /** Number of re-seeds that were forced because a pseudorandom number
+     *  generator had produced too much output since the last re-seed */
+    uint64_t auto_reseeds;
+
+    /** Number of forward security re-keys of pseudorandom number
+     *  generator states */
+    uint64_t rekeys;
+
+    /** Number of permutation calls that were used to expand TRNG
+     *  seeds into masking material */
+    uint64_t mixer_permutations;
+
+} ascon_random_stats_t;
+
 /**
  * \brief Gets a block of random data from the system.
  *
@@ -81,6 +141,15 @@ typedef struct
  * remove any watermarks or bias from untrustworthy TRNG's.  And it
  * will spread the entropy uniformly throughout the returned data.
  *
+ * On platforms with thread-local storage, requests are served from a
+ * per-thread PRNG that is seeded from the system random number source on
+ * first use and periodically re-seeded after that.  This avoids a system
+ * call for every nonce or salt.  If the process forks, then the PRNG in
+ * the child process is seeded again from scratch.  The return value
+ * reflects the state of the system random number source when the
+ * per-thread PRNG was last seeded.  See ascon_random_shared_fetch()
+ * for more information.
+ *
  * This function is suitable for relatively rare events such as the
  * generation of session keys or password salts.  If you need a large
  * amount of continuous random data, then use ascon_random_init() instead.
@@ -89,6 +158,60 @@ typedef struct
  */
 int ascon_random(unsigned char *out, size_t outlen);
 
+/**
+ * \brief Fetches data from the process-wide shared pseudorandom
+ * number generator.
+ *
+ * \param out Buffer to fill with the random data.
+ * \param outlen Number of bytes of random data to generate.
+ *
+ * \return Non-zero if the system random number source is working;
+ * zero if there is no system random number source or it has failed.
+ *
+ * This function is thread-safe.  On platforms with thread-local storage,
+ * the shared generator is made up of one ascon_random_pool_t shard per
+ * thread.  Each shard is seeded independently from the system random
+ * number source when the thread first uses it, so threads never wait
+ * on a lock to get random data.  If the process forks, then the shard
+ * in the child is seeded again from scratch.  Platforms without
+ * thread-local storage seed every request directly from the system
+ * random number source instead.
+ *
+ * This is the same generator that is used by ascon_random().
+ *
+ * \sa ascon_random_shared_reseed(), ascon_random_shared_release()
+ */
+int ascon_random_shared_fetch(unsigned char *out, size_t outlen);
+
+/**
+ * \brief Re-seeds every shard of the process-wide shared pseudorandom
+ * number generator from the system random number source.
+ *
+ * \return Non-zero if the system random number source is working;
+ * zero if there is no system random number source or it has failed.
+ *
+ * The shard for the calling thread is re-seeded immediately.  The shards
+ * for other threads are re-seeded the next time that they are used.
+ *
+ * \sa ascon_random_shared_fetch()
+ */
+int ascon_random_shared_reseed(void);
+
+/**
+ * \brief Destroys the calling thread's shard of the process-wide shared
+ * pseudorandom number generator.
+ *
+ * Threads do not normally need to call this because the shard is
+ * destroyed automatically when the thread exits on platforms with
+ * POSIX threads.  It is provided for other thread libraries, and for
+ * long-lived threads that want to wipe the state after a burst of
+ * activity.  The shard will be seeded again if the thread asks for
+ * more random data later.
+ *
+ * \sa ascon_random_shared_fetch()
+ */
+void ascon_random_shared_release(void);
+
 /**
  * \brief Initializes a pseudorandom number generator from the
  * system random number source.
@@ -111,6 +234,32 @@ int ascon_random(unsigned char *out, size_t outlen);
  */
 int ascon_random_init(ascon_random_state_t *state);
 
+/**
+ * \brief Initializes a deterministic pseudorandom number generator
+ * from an application-supplied seed.
+ *
+ * \param state The pseudorandom number generator state to initialize.
+ * \param seed Points to the seed.
+ * \param seedlen Length of the seed in bytes.
+ *
+ * The system random number source is never consulted, not even to
+ * automatically re-seed the generator.  Two generators that are
+ * initialized with the same seed will produce the same output on every
+ * platform, provided that the same sequence of calls is made on both.
+ * This is intended for reproducible benchmarks and test vectors.
+ *
+ * Calling ascon_random_reseed() or ascon_random_load_seed() on the
+ * \a state will mix in the system random number source and turn it
+ * into a regular non-deterministic generator.
+ *
+ * \warning The output is only as unpredictable as the seed.  Do not use
+ * this to generate keys unless the seed is itself a secret random value.
+ *
+ * \sa ascon_random_init(), ascon_random_generate()
+ */
+void ascon_random_init_deterministic
+    (ascon_random_state_t *state, const unsigned char *seed, size_t seedlen);
+
 /**
  * \brief Frees a pseudorandom number generator and destroys any
  * sensitive values.
@@ -133,6 +282,32 @@ void ascon_random_free(ascon_random_state_t *state);
 void ascon_random_fetch
     (ascon_random_state_t *state, unsigned char *out, size_t outlen);
 
+/**
+ * \brief Generates bulk data from a pseudorandom number generator
+ * without re-keying it afterwards.
+ *
+ * \param state The pseudorandom number generator state to use.
+ * \param out Points to a buffer to receive the random data.
+ * \param outlen Number of bytes of random data to generate.
+ *
+ * This is faster than ascon_random_fetch() for many small requests
+ * because it squeezes a full rate block per permutation and skips the
+ * forward security re-key at the end of each call.
+ *
+ * For generators that were created with ascon_random_init_deterministic(),
+ * consecutive calls produce the same output as a single call for the
+ * combined length.  This is not true of other generators because they
+ * may re-seed from the system random number source between calls.
+ *
+ * Previous output can be recovered from the \a state until it is next
+ * re-keyed.  Call ascon_random_fetch() or ascon_random_feed() with no
+ * entropy to re-key the state once the bulk data has been generated.
+ *
+ * \sa ascon_random_fetch(), ascon_random_init_deterministic()
+ */
+void ascon_random_generate
+    (ascon_random_state_t *state, unsigned char *out, size_t outlen);
+
 /**
  * \brief Explicitly re-seeds a pseudorandom number generator from the
  * system random number source.
@@ -213,6 +388,122 @@ int ascon_random_save_seed
 int ascon_random_load_seed
     (ascon_random_state_t *state, const ascon_storage_t *storage);
 
+/**
+ * \brief Initializes a buffered pseudorandom number generator from the
+ * system random number source.
+ *
+ * \param pool The buffered pseudorandom number generator to initialize.
+ *
+ * \return Non-zero if the system random number source is working;
+ * zero if there is no system random number source or it has failed.
+ *
+ * ascon_random_fetch() re-keys the generator after every request, which
+ * costs several permutation calls.  A buffered generator instead squeezes
+ * ASCON_RANDOM_POOL_SIZE bytes at a time and re-keys once per refill.
+ * Small requests are served from the pool and the bytes are wiped from
+ * the pool as they are returned.  Previous output cannot be recovered
+ * from the state, but unused bytes in the pool are visible to an attacker
+ * who captures the state.
+ *
+ * The \a pool must be freed explicitly with ascon_random_pool_free()
+ * regardless of the return value from this function.
+ *
+ * \sa ascon_random_pool_fetch(), ascon_random_init()
+ */
+int ascon_random_pool_init(ascon_random_pool_t *pool);
+
+/**
+ * \brief Initializes a deterministic buffered pseudorandom number
+ * generator from an application-supplied seed.
+ *
+ * \param pool The buffered pseudorandom number generator to initialize.
+ * \param seed Points to the seed.
+ * \param seedlen Length of the seed in bytes.
+ *
+ * This is the buffered equivalent of ascon_random_init_deterministic().
+ *
+ * \sa ascon_random_init_deterministic(), ascon_random_pool_init()
+ */
+void ascon_random_pool_init_deterministic
+    (ascon_random_pool_t *pool, const unsigned char *seed, size_t seedlen);
+
+/**
+ * \brief Frees a buffered pseudorandom number generator and destroys
+ * any sensitive values.
+ *
+ * \param pool The buffered pseudorandom number generator to free.
+ */
+void ascon_random_pool_free(ascon_random_pool_t *pool);
+
+/**
+ * \brief Fetches data from a buffered pseudorandom number generator.
+ *
+ * \param pool The buffered pseudorandom number generator to use.
+ * \param out Points to a buffer to receive the random data.
+ * \param outlen Number of bytes of random data to fetch.
+ *
+ * Requests that are larger than the pool are squeezed directly from
+ * the underlying generator.
+ */
+void ascon_random_pool_fetch
+    (ascon_random_pool_t *pool, unsigned char *out, size_t outlen);
+
+/**
+ * \brief Explicitly re-seeds a buffered pseudorandom number generator
+ * from the system random number source.
+ *
+ * \param pool The buffered pseudorandom number generator to re-seed.
+ *
+ * \return Non-zero if the system random number source is working;
+ * zero if there is no system random number source or it has failed.
+ *
+ * Any unused output in the pool is discarded.
+ */
+int ascon_random_pool_reseed(ascon_random_pool_t *pool);
+
+/**
+ * \brief Feeds entropy into a buffered pseudorandom number generator.
+ *
+ * \param pool The buffered pseudorandom number generator to feed
+ * the entropy into.
+ * \param entropy Points to a buffer containing the entropy.
+ * \param size Number of bytes of entropy to add.
+ *
+ * Any unused output in the pool is discarded.
+ *
+ * \sa ascon_random_feed()
+ */
+void ascon_random_pool_feed
+    (ascon_random_pool_t *pool, const unsigned char *entropy, size_t size);
+
+/**
+ * \brief Gets the instrumentation counters for the random number sources.
+ *
+ * \param stats Returns the current counter values.
+ *
+ * \return Non-zero if the library was built with ASCON_RANDOM_STATS
+ * defined, or zero if instrumentation is not available.  All counters
+ * are set to zero if instrumentation is not available.
+ *
+ * The counters are process-wide and are shared between all threads.
+ * They are intended for checking that the random number sources are not
+ * a hidden performance problem, such as making a system call for every
+ * nonce.  Counting adds a small overhead to each operation, so it is
+ * disabled by default.  Use the RANDOM_STATS option to enable it in
+ * CMake builds.
+ *
+ * \sa ascon_random_reset_stats()
+ */
+int ascon_random_get_stats(ascon_random_stats_t *stats);
+
+/**
+ * \brief Resets the instrumentation counters for the random number
+ * sources to zero.
+ *
+ * \sa ascon_random_get_stats()
+ */
+void ascon_random_reset_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
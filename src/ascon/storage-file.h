@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2023 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef ASCON_STORAGE_FILE_H
+#define ASCON_STORAGE_FILE_H
+
+#include <ascon/storage.h>
+
+/**
+ * \file storage-file.h
+ * \brief Non-volatile storage that is backed by a file on a POSIX system.
+ *
+ * This storage driver allows ascon_random_save_seed() and
+ * ascon_random_load_seed() to be used on servers, so that a service can
+ * restore its PRNG state quickly at boot and persist it on shutdown.
+ *
+ * Every write is atomic: the whole region is written to a temporary file
+ * which is then renamed over the top of the original.  A crash part-way
+ * through a write leaves either the old contents or the new contents,
+ * never a mixture of the two.
+ *
+ * The temporary file is always flushed to disk with fsync() before the
+ * rename.  Flushing the directory to make the rename itself durable is
+ * expensive, so it can be batched.  The \a sync_interval parameter to
+ * ascon_file_storage_init() sets the number of writes between directory
+ * flushes.  A write whose rename has not been flushed yet may be lost
+ * if the system crashes, leaving the previous contents of the file.
+ * Call ascon_file_storage_sync() to flush explicitly.
+ *
+ * The temporary file is created next to the original with a unique name
+ * from mkstemp().  On platforms without mkstemp(), the fixed name
+ * "<path>.XXXXXX" is used instead and any stale file with that name is
+ * removed first, so only one process should write to a given file.
+ *
+ * \code
+ * ascon_file_storage_t file;
+ * ascon_random_state_t prng;
+ *
+ * ascon_file_storage_init
+ *     (&file, "/var/lib/myservice/seed", ASCON_RANDOM_SAVED_SEED_SIZE, 1);
+ * ascon_random_init(&prng);
+ * ascon_random_load_seed(&prng, &(file.storage));
+ * ...
+ * ascon_random_save_seed(&prng, &(file.storage));
+ * ascon_file_storage_free(&file);
+ * \endcode
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Maximum length of the path to a file-backed storage region,
+ * including the terminating NUL.
+ */
+#define ASCON_FILE_STORAGE_MAX_PATH 256
+
+/**
+ * \brief Information about a file-backed storage region.
+ */
+typedef struct
+{
+    /** Storage information block to pass to functions that take
+     *  an ascon_storage_t.  This must be the first field. */
+    ascon_storage_t storage;
+
+    /** Path to the file */
+    char path[ASCON_FILE_STORAGE_MAX_PATH];
+
+    /** Number of writes between directory flushes, or 0 to only flush
+     *  the directory when ascon_file_storage_sync() is called */
+    unsigned sync_interval;
+
+    /** Number of writes since the directory was last flushed */
+    unsigned pending;
+
+} ascon_file_storage_t;
+
+/**
+ * \brief Initializes a file-backed storage region.
+ *
+ * \param file The file-backed storage region to initialize.
+ * \param path Path to the file to use.
+ * \param size Size of the storage region in bytes.
+ * \param sync_interval Number of writes between directory flushes, or 0
+ * to only flush the directory when ascon_file_storage_sync() is called.
+ *
+ * \return 0 on success, or -1 if the path is too long or file-backed
+ * storage is not supported on this platform.
+ *
+ * The file does not need to exist yet.  Reads from a file that does not
+ * exist will fail, and it will be created on the first write.  Bytes that
+ * have not been written yet read as 0xFF, like erased flash memory.
+ *
+ * \sa ascon_file_storage_free(), ascon_file_storage_sync()
+ */
+int ascon_file_storage_init
+    (ascon_file_storage_t *file, const char *path, size_t size,
+     unsigned sync_interval);
+
+/**
+ * \brief Frees a file-backed storage region, syncing any writes that
+ * are still pending.
+ *
+ * \param file The file-backed storage region to free.
+ */
+void ascon_file_storage_free(ascon_file_storage_t *file);
+
+/**
+ * \brief Syncs the writes to a file-backed storage region to disk.
+ *
+ * \param file The file-backed storage region to sync.
+ *
+ * \return 0 on success, or -1 on error.
+ *
+ * This does nothing if there are no pending writes.
+ */
+int ascon_file_storage_sync(ascon_file_storage_t *file);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
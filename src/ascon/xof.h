@@ -76,6 +76,34 @@ typedef struct
 
 } ascon_xofa_state_t;
 
+/**
+ * \brief Pre-computed ASCON-XOF state for a specific function name,
+ * customization string, and output length.
+ *
+ * Absorbing the function name and customization string requires extra
+ * calls to the permutation.  If the same parameters are used over and
+ * over, then the initialized state can be computed once with
+ * ascon_xof_precompute() and then cloned into new XOF states with
+ * ascon_xof_init_precomputed().
+ */
+typedef struct
+{
+    ascon_xof_state_t xof;  /**< Initialized XOF state to clone from */
+
+} ascon_xof_precomputed_t;
+
+/**
+ * \brief Pre-computed ASCON-XOFA state for a specific function name,
+ * customization string, and output length.
+ *
+ * \sa ascon_xofa_precompute(), ascon_xofa_init_precomputed()
+ */
+typedef struct
+{
+    ascon_xofa_state_t xof; /**< Initialized XOF state to clone from */
+
+} ascon_xofa_precomputed_t;
+
 /**
  * \brief Hashes a block of input data with ASCON-XOF and generates a
  * fixed-length 32 byte output.
@@ -239,6 +267,65 @@ void ascon_xof_pad(ascon_xof_state_t *state);
  */
 void ascon_xof_copy(ascon_xof_state_t *dest, const ascon_xof_state_t *src);
 
+/**
+ * \brief Pre-computes the initial state for an incremental ASCON-XOF
+ * operation with a named function, customization string, and output length.
+ *
+ * \param pre Pre-computed state to be initialized.
+ * \param function_name Name of the function; e.g. "KMAC".  May be NULL or
+ * empty for no function name.
+ * \param custom Points to the customization string.
+ * \param customlen Number of bytes in the customization string.
+ * \param outlen The desired output length in bytes, or 0 for arbitrary-length.
+ *
+ * The pre-computed state must be freed with ascon_xof_precomputed_free()
+ * when it is no longer required.
+ *
+ * \sa ascon_xof_init_precomputed(), ascon_xof_init_custom()
+ */
+void ascon_xof_precompute
+    (ascon_xof_precomputed_t *pre, const char *function_name,
+     const unsigned char *custom, size_t customlen, size_t outlen);
+
+/**
+ * \brief Initializes the state for an incremental ASCON-XOF operation
+ * from a pre-computed state.
+ *
+ * \param state XOF state to be initialized.
+ * \param pre Points to the pre-computed state.
+ *
+ * The result is identical to calling ascon_xof_init_custom() with the
+ * parameters that were passed to ascon_xof_precompute(), but only
+ * requires a copy of the state rather than extra permutation calls.
+ *
+ * \sa ascon_xof_precompute()
+ */
+void ascon_xof_init_precomputed
+    (ascon_xof_state_t *state, const ascon_xof_precomputed_t *pre);
+
+/**
+ * \brief Re-initializes the state for an incremental ASCON-XOF operation
+ * from a pre-computed state.
+ *
+ * \param state XOF state to be re-initialized.
+ * \param pre Points to the pre-computed state.
+ *
+ * This function is equivalent to calling ascon_xof_free() and then
+ * ascon_xof_init_precomputed() to restart the hashing process.
+ *
+ * \sa ascon_xof_init_precomputed()
+ */
+void ascon_xof_reinit_precomputed
+    (ascon_xof_state_t *state, const ascon_xof_precomputed_t *pre);
+
+/**
+ * \brief Frees a pre-computed ASCON-XOF state and destroys any
+ * sensitive material.
+ *
+ * \param pre Pre-computed state to be freed.
+ */
+void ascon_xof_precomputed_free(ascon_xof_precomputed_t *pre);
+
 /**
  * \brief Hashes a block of input data with ASCON-XOFA and generates a
  * fixed-length 32 byte output.
@@ -402,6 +489,65 @@ void ascon_xofa_pad(ascon_xofa_state_t *state);
  */
 void ascon_xofa_copy(ascon_xofa_state_t *dest, const ascon_xofa_state_t *src);
 
+/**
+ * \brief Pre-computes the initial state for an incremental ASCON-XOFA
+ * operation with a named function, customization string, and output length.
+ *
+ * \param pre Pre-computed state to be initialized.
+ * \param function_name Name of the function; e.g. "KMAC".  May be NULL or
+ * empty for no function name.
+ * \param custom Points to the customization string.
+ * \param customlen Number of bytes in the customization string.
+ * \param outlen The desired output length in bytes, or 0 for arbitrary-length.
+ *
+ * The pre-computed state must be freed with ascon_xofa_precomputed_free()
+ * when it is no longer required.
+ *
+ * \sa ascon_xofa_init_precomputed(), ascon_xofa_init_custom()
+ */
+void ascon_xofa_precompute
+    (ascon_xofa_precomputed_t *pre, const char *function_name,
+     const unsigned char *custom, size_t customlen, size_t outlen);
+
+/**
+ * \brief Initializes the state for an incremental ASCON-XOFA operation
+ * from a pre-computed state.
+ *
+ * \param state XOF state to be initialized.
+ * \param pre Points to the pre-computed state.
+ *
+ * The result is identical to calling ascon_xofa_init_custom() with the
+ * parameters that were passed to ascon_xofa_precompute(), but only
+ * requires a copy of the state rather than extra permutation calls.
+ *
+ * \sa ascon_xofa_precompute()
+ */
+void ascon_xofa_init_precomputed
+    (ascon_xofa_state_t *state, const ascon_xofa_precomputed_t *pre);
+
+/**
+ * \brief Re-initializes the state for an incremental ASCON-XOFA operation
+ * from a pre-computed state.
+ *
+ * \param state XOF state to be re-initialized.
+ * \param pre Points to the pre-computed state.
+ *
+ * This function is equivalent to calling ascon_xofa_free() and then
+ * ascon_xofa_init_precomputed() to restart the hashing process.
+ *
+ * \sa ascon_xofa_init_precomputed()
+ */
+void ascon_xofa_reinit_precomputed
+    (ascon_xofa_state_t *state, const ascon_xofa_precomputed_t *pre);
+
+/**
+ * \brief Frees a pre-computed ASCON-XOFA state and destroys any
+ * sensitive material.
+ *
+ * \param pre Pre-computed state to be freed.
+ */
+void ascon_xofa_precomputed_free(ascon_xofa_precomputed_t *pre);
+
 #ifdef __cplusplus
 } /* extern "C" */
 
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/* Plain C implementation of the ASCON permutation on two states at once,
+ * for the backends that store the state as five 64-bit words. */
+
+#include "ascon-permute-2way.h"
+#include "ascon-util.h"
+
+#if defined(ASCON_PERMUTE_2WAY)
+
+#define ROUND_CONSTANT(round)   \
+        (~(uint64_t)(((0x0F - (round)) << 4) | (round)))
+
+/* Substitution and linear diffusion layers for one state; the round
+ * constant must already have been added to x2 */
+#define ASCON_ROUND_2WAY(x0, x1, x2, x3, x4, t0, t1, t2, t3, t4) \
+    do { \
+        x0 ^= x4;   x4 ^= x3;   x2 ^= x1; \
+        t0 = ~x0;   t1 = ~x1;   t2 = ~x2;   t3 = ~x3;   t4 = ~x4; \
+        t0 &= x1;   t1 &= x2;   t2 &= x3;   t3 &= x4;   t4 &= x0; \
+        x0 ^= t1;   x1 ^= t2;   x2 ^= t3;   x3 ^= t4;   x4 ^= t0; \
+        x1 ^= x0;   x0 ^= x4;   x3 ^= x2; \
+        x0 ^= rightRotate19_64(x0) ^ rightRotate28_64(x0); \
+        x1 ^= rightRotate61_64(x1) ^ rightRotate39_64(x1); \
+        x2 ^= rightRotate1_64(x2)  ^ rightRotate6_64(x2); \
+        x3 ^= rightRotate10_64(x3) ^ rightRotate17_64(x3); \
+        x4 ^= rightRotate7_64(x4)  ^ rightRotate41_64(x4); \
+    } while (0)
+
+void ascon_permute_2way
+    (ascon_state_t *state1, ascon_state_t *state2, uint8_t first_round)
+{
+    static const uint64_t RC[12] = {
+        ROUND_CONSTANT(0),
+        ROUND_CONSTANT(1),
+        ROUND_CONSTANT(2),
+        ROUND_CONSTANT(3),
+        ROUND_CONSTANT(4),
+        ROUND_CONSTANT(5),
+        ROUND_CONSTANT(6),
+        ROUND_CONSTANT(7),
+        ROUND_CONSTANT(8),
+        ROUND_CONSTANT(9),
+        ROUND_CONSTANT(10),
+        ROUND_CONSTANT(11)
+    };
+    uint64_t t0, t1, t2, t3, t4;
+    uint64_t u0, u1, u2, u3, u4;
+    uint64_t x0 = state1->S[0];
+    uint64_t x1 = state1->S[1];
+    uint64_t x2 = ~(state1->S[2]);
+    uint64_t x3 = state1->S[3];
+    uint64_t x4 = state1->S[4];
+    uint64_t y0 = state2->S[0];
+    uint64_t y1 = state2->S[1];
+    uint64_t y2 = ~(state2->S[2]);
+    uint64_t y3 = state2->S[3];
+    uint64_t y4 = state2->S[4];
+    while (first_round < 12) {
+        /* The "x2 = ~x2" step of the s-box is folded into the inverted
+         * round constant, as in the single-state "c64" backend */
+        x2 ^= RC[first_round];
+        y2 ^= RC[first_round];
+        ASCON_ROUND_2WAY(x0, x1, x2, x3, x4, t0, t1, t2, t3, t4);
+        ASCON_ROUND_2WAY(y0, y1, y2, y3, y4, u0, u1, u2, u3, u4);
+        ++first_round;
+    }
+    state1->S[0] = x0;
+    state1->S[1] = x1;
+    state1->S[2] = ~x2;
+    state1->S[3] = x3;
+    state1->S[4] = x4;
+    state2->S[0] = y0;
+    state2->S[1] = y1;
+    state2->S[2] = ~y2;
+    state2->S[3] = y3;
+    state2->S[4] = y4;
+}
+
+#endif /* ASCON_PERMUTE_2WAY */
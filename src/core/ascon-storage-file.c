@@ -0,0 +1,317 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#define _GNU_SOURCE
+#if defined(HAVE_CONFIG_H)
+#include <config.h>
+#endif
+#include <ascon/storage-file.h>
+#include <ascon/utility.h>
+#include <string.h>
+
+#if defined(HAVE_UNISTD_H) && defined(HAVE_FCNTL_H) && \
+        defined(HAVE_OPEN) && defined(HAVE_FSYNC)
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * \brief Size of the chunks to use when copying the old file contents.
+ */
+#define ASCON_FILE_STORAGE_CHUNK 256
+
+/**
+ * \brief Suffix to add to the path to get the name of the temporary file.
+ *
+ * With mkstemp(), the X's are replaced with a unique string so that
+ * concurrent writers do not clobber each other's temporary files.
+ * Without mkstemp(), the suffix is used as-is and a stale temporary file
+ * that was left behind by a crash is removed before it is created again.
+ */
+#define ASCON_FILE_STORAGE_SUFFIX ".XXXXXX"
+
+/* Open directories read-only for syncing.  Symlinks are followed so that
+ * the directory that actually contains the file is the one synced. */
+#if defined(O_DIRECTORY)
+#define ASCON_FILE_DIR_FLAGS (O_RDONLY | O_DIRECTORY)
+#else
+#define ASCON_FILE_DIR_FLAGS O_RDONLY
+#endif
+
+/**
+ * \brief Reads from a file, retrying if interrupted.
+ *
+ * \param fd The file descriptor.
+ * \param offset Offset to read from.
+ * \param data Buffer to read into.
+ * \param size Number of bytes to read.
+ *
+ * \return The number of bytes read, which may be short at the end of
+ * the file, or -1 on error.
+ */
+static int ascon_file_read_at
+    (int fd, size_t offset, unsigned char *data, size_t size)
+{
+    size_t done = 0;
+    ssize_t len;
+    while (done < size) {
+        len = pread(fd, data + done, size - done, (off_t)(offset + done));
+        if (len < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        } else if (len == 0) {
+            break;
+        }
+        done += (size_t)len;
+    }
+    return (int)done;
+}
+
+/**
+ * \brief Writes to a file, retrying if interrupted.
+ *
+ * \param fd The file descriptor.
+ * \param data Buffer to write from.
+ * \param size Number of bytes to write.
+ *
+ * \return 0 on success or -1 on error.
+ */
+static int ascon_file_write_all
+    (int fd, const unsigned char *data, size_t size)
+{
+    ssize_t len;
+    while (size > 0) {
+        len = write(fd, data, size);
+        if (len < 0) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        data += len;
+        size -= (size_t)len;
+    }
+    return 0;
+}
+
+/**
+ * \brief Syncs the directory that contains a file so that a rename
+ * is persisted.
+ *
+ * \param path The path to the file.
+ *
+ * \return 0 on success or -1 on error.
+ */
+static int ascon_file_sync_dir(const char *path)
+{
+    char dir[ASCON_FILE_STORAGE_MAX_PATH];
+    const char *slash = strrchr(path, '/');
+    int fd, result;
+    if (!slash) {
+        dir[0] = '.';
+        dir[1] = '\0';
+    } else if (slash == path) {
+        dir[0] = '/';
+        dir[1] = '\0';
+    } else {
+        memcpy(dir, path, (size_t)(slash - path));
+        dir[slash - path] = '\0';
+    }
+    fd = open(dir, ASCON_FILE_DIR_FLAGS);
+    if (fd < 0)
+        return -1;
+    result = fsync(fd);
+    close(fd);
+    return result < 0 ? -1 : 0;
+}
+
+static int ascon_file_storage_read
+    (const ascon_storage_t *storage, size_t offset,
+     unsigned char *data, size_t size)
+{
+    const ascon_file_storage_t *file = (const ascon_file_storage_t *)storage;
+    int fd, len;
+    if (offset > storage->size || size > (storage->size - offset))
+        return -1;
+    fd = open(file->path, O_RDONLY);
+    if (fd < 0)
+        return -1;
+    len = ascon_file_read_at(fd, offset, data, size);
+    close(fd);
+    return len;
+}
+
+static int ascon_file_storage_write
+    (const ascon_storage_t *storage, size_t offset,
+     const unsigned char *data, size_t size, int erase)
+{
+    /* The descriptor is const but the containing object is not */
+    ascon_file_storage_t *file = (ascon_file_storage_t *)storage;
+    char tmp_path
+        [ASCON_FILE_STORAGE_MAX_PATH + sizeof(ASCON_FILE_STORAGE_SUFFIX)];
+    unsigned char chunk[ASCON_FILE_STORAGE_CHUNK];
+    size_t posn, len, start, end;
+    int old_fd, new_fd;
+    int ok = 1;
+
+    /* Validate the parameters */
+    if (offset > storage->size || size > (storage->size - offset))
+        return -1;
+    if (!data && !erase)
+        return -1;
+
+    /* Create the temporary file in the same directory as the original.
+     * Never reuse or follow an existing file or symlink at that name. */
+    strcpy(tmp_path, file->path);
+    strcat(tmp_path, ASCON_FILE_STORAGE_SUFFIX);
+#if defined(HAVE_MKSTEMP)
+    new_fd = mkstemp(tmp_path);
+#else
+    new_fd = open(tmp_path, O_WRONLY | O_CREAT | O_EXCL, 0600);
+    if (new_fd < 0 && errno == EEXIST) {
+        /* Left behind by a crash; unlink() removes a symlink and not
+         * the file that it points to, so this is safe to retry */
+        unlink(tmp_path);
+        new_fd = open(tmp_path, O_WRONLY | O_CREAT | O_EXCL, 0600);
+    }
+#endif
+    if (new_fd < 0)
+        return -1;
+
+    /* Copy the old contents across, replacing the written region.
+     * Missing bytes read as 0xFF, as do erased bytes if no data. */
+    old_fd = open(file->path, O_RDONLY);
+    for (posn = 0; ok && posn < storage->size; posn += len) {
+        len = storage->size - posn;
+        if (len > ASCON_FILE_STORAGE_CHUNK)
+            len = ASCON_FILE_STORAGE_CHUNK;
+        memset(chunk, 0xFF, len);
+        if (old_fd >= 0 && ascon_file_read_at(old_fd, posn, chunk, len) < 0)
+            ok = 0;
+        start = posn > offset ? posn : offset;
+        end = (posn + len) < (offset + size) ? (posn + len) : (offset + size);
+        if (start < end) {
+            if (data) {
+                memcpy(chunk + start - posn, data + start - offset,
+                       end - start);
+            } else {
+                memset(chunk + start - posn, 0xFF, end - start);
+            }
+        }
+        if (ok && ascon_file_write_all(new_fd, chunk, len) < 0)
+            ok = 0;
+    }
+    if (old_fd >= 0)
+        close(old_fd);
+    ascon_clean(chunk, sizeof(chunk));
+
+    /* The data must always be on disk before the rename, or a crash
+     * could leave an empty or zero-filled file under the original name */
+    if (ok && fsync(new_fd) < 0)
+        ok = 0;
+    if (close(new_fd) < 0)
+        ok = 0;
+
+    /* Atomically replace the old file with the new one */
+    if (ok && rename(tmp_path, file->path) < 0)
+        ok = 0;
+    if (!ok) {
+        unlink(tmp_path);
+        return -1;
+    }
+
+    /* Only the directory sync that persists the rename is batched */
+    ++(file->pending);
+    if (file->sync_interval != 0 && file->pending >= file->sync_interval) {
+        if (ascon_file_sync_dir(file->path) < 0)
+            return -1;
+        file->pending = 0;
+    }
+    return (int)size;
+}
+
+int ascon_file_storage_init
+    (ascon_file_storage_t *file, const char *path, size_t size,
+     unsigned sync_interval)
+{
+    size_t len = strlen(path);
+    memset(file, 0, sizeof(ascon_file_storage_t));
+    if (len >= ASCON_FILE_STORAGE_MAX_PATH || len == 0)
+        return -1;
+    memcpy(file->path, path, len + 1);
+    file->storage.page_size = 1;
+    file->storage.erase_size = 0;
+    file->storage.address = 0;
+    file->storage.size = size;
+    file->storage.partial_writes = 0;
+    file->storage.read = ascon_file_storage_read;
+    file->storage.write = ascon_file_storage_write;
+    file->sync_interval = sync_interval;
+    file->pending = 0;
+    return 0;
+}
+
+int ascon_file_storage_sync(ascon_file_storage_t *file)
+{
+    if (!file->pending)
+        return 0;
+    if (ascon_file_sync_dir(file->path) < 0)
+        return -1;
+    file->pending = 0;
+    return 0;
+}
+
+#else /* No POSIX file support */
+
+int ascon_file_storage_init
+    (ascon_file_storage_t *file, const char *path, size_t size,
+     unsigned sync_interval)
+{
+    (void)path;
+    (void)size;
+    (void)sync_interval;
+    memset(file, 0, sizeof(ascon_file_storage_t));
+    return -1;
+}
+
+int ascon_file_storage_sync(ascon_file_storage_t *file)
+{
+    (void)file;
+    return -1;
+}
+
+#endif /* No POSIX file support */
+
+void ascon_file_storage_free(ascon_file_storage_t *file)
+{
+    if (file) {
+        if (file->pending)
+            ascon_file_storage_sync(file);
+        memset(file, 0, sizeof(ascon_file_storage_t));
+    }
+}
@@ -0,0 +1,302 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <ascon/bloom.h>
+#include "core/ascon-util.h"
+#include <string.h>
+
+/**
+ * \brief Number of keys to locate up front in the batch functions.
+ */
+#define ASCON_BLOOM_BATCH_SIZE 8
+
+/**
+ * \brief Number of bytes to squeeze for each key: 8 bytes to select the
+ * block and 2 bytes for each bit within the block.
+ */
+#define ASCON_BLOOM_SQUEEZE_SIZE(k) (8 + (k) * 2)
+
+/**
+ * \brief Number of bits in a block, minus 1.
+ */
+#define ASCON_BLOOM_BIT_MASK (ASCON_BLOOM_BLOCK_SIZE * 8 - 1)
+
+/**
+ * \brief Current version of the serialization format.
+ */
+#define ASCON_BLOOM_VERSION 1
+
+/* Prefetch a block of the filter into the cache if the compiler knows how */
+#if defined(__GNUC__) || defined(__clang__)
+#define ascon_bloom_prefetch(addr) __builtin_prefetch((addr))
+#else
+#define ascon_bloom_prefetch(addr) do { (void)(addr); } while (0)
+#endif
+
+/**
+ * \brief Location of a key within a Bloom filter.
+ */
+typedef struct
+{
+    unsigned char *block;   /**< Points to the block for the key */
+    unsigned char out[ASCON_BLOOM_SQUEEZE_SIZE(ASCON_BLOOM_MAX_HASHES)];
+                            /**< Output from the XOF with the bit indices */
+
+} ascon_bloom_location_t;
+
+/**
+ * \brief Reduces a 64-bit random value into a range.
+ *
+ * \param value The random value.
+ * \param range The range, which must be non-zero.
+ *
+ * \return A value between 0 and \a range - 1.
+ */
+static size_t ascon_bloom_reduce(uint64_t value, size_t range)
+{
+    if (((uint64_t)range) <= 0xFFFFFFFFULL)
+        return (size_t)(((value >> 32) * range) >> 32);
+    return (size_t)(value % range);
+}
+
+/**
+ * \brief Locates a key within a Bloom filter.
+ *
+ * \param filter The Bloom filter.
+ * \param loc Returns the location of the key.
+ * \param in Points to the key.
+ * \param inlen Length of the key in bytes.
+ */
+static void ascon_bloom_locate
+    (const ascon_bloom_filter_t *filter, ascon_bloom_location_t *loc,
+     const unsigned char *in, size_t inlen)
+{
+    ascon_xof_state_t xof;
+    size_t block;
+    ascon_xof_init_precomputed(&xof, &(filter->xof));
+    ascon_xof_absorb(&xof, in, inlen);
+    ascon_xof_squeeze(&xof, loc->out, ASCON_BLOOM_SQUEEZE_SIZE(filter->k));
+    ascon_xof_free(&xof);
+    block = ascon_bloom_reduce(be_load_word64(loc->out), filter->num_blocks);
+    loc->block = filter->bits + block * ASCON_BLOOM_BLOCK_SIZE;
+}
+
+/**
+ * \brief Sets the bits for a key that has been located.
+ *
+ * \param filter The Bloom filter.
+ * \param loc Location of the key.
+ */
+static void ascon_bloom_set
+    (const ascon_bloom_filter_t *filter, const ascon_bloom_location_t *loc)
+{
+    unsigned index, bit;
+    for (index = 0; index < filter->k; ++index) {
+        bit = be_load_word16(loc->out + 8 + index * 2) & ASCON_BLOOM_BIT_MASK;
+        loc->block[bit / 8] |= (unsigned char)(1U << (bit % 8));
+    }
+}
+
+/**
+ * \brief Tests the bits for a key that has been located.
+ *
+ * \param filter The Bloom filter.
+ * \param loc Location of the key.
+ *
+ * \return Non-zero if all bits are set, or zero otherwise.
+ */
+static int ascon_bloom_test
+    (const ascon_bloom_filter_t *filter, const ascon_bloom_location_t *loc)
+{
+    unsigned index, bit;
+    for (index = 0; index < filter->k; ++index) {
+        bit = be_load_word16(loc->out + 8 + index * 2) & ASCON_BLOOM_BIT_MASK;
+        if (!(loc->block[bit / 8] & (1U << (bit % 8))))
+            return 0;
+    }
+    return 1;
+}
+
+void ascon_multi_index
+    (uint32_t *indices, unsigned count, uint32_t range,
+     const unsigned char *in, size_t inlen)
+{
+    ascon_xof_state_t xof;
+    unsigned char out[64];
+    unsigned index, len;
+    ascon_xof_init_custom(&xof, "MultiIndex", 0, 0, 0);
+    ascon_xof_absorb(&xof, in, inlen);
+    while (count > 0) {
+        len = count;
+        if (len > sizeof(out) / 4)
+            len = sizeof(out) / 4;
+        ascon_xof_squeeze(&xof, out, len * 4);
+        for (index = 0; index < len; ++index) {
+            *indices++ = (uint32_t)
+                ((be_load_word32(out + index * 4) * (uint64_t)range) >> 32);
+        }
+        count -= len;
+    }
+    ascon_xof_free(&xof);
+}
+
+int ascon_bloom_init
+    (ascon_bloom_filter_t *filter, unsigned char *bits,
+     size_t size, unsigned k)
+{
+    if (size < ASCON_BLOOM_BLOCK_SIZE || k < 1 || k > ASCON_BLOOM_MAX_HASHES)
+        return -1;
+    filter->bits = bits;
+    filter->num_blocks = size / ASCON_BLOOM_BLOCK_SIZE;
+    filter->k = k;
+    ascon_xof_precompute(&(filter->xof), "Bloom", 0, 0, 0);
+    ascon_bloom_clear(filter);
+    return 0;
+}
+
+void ascon_bloom_free(ascon_bloom_filter_t *filter)
+{
+    if (filter) {
+        ascon_xof_precomputed_free(&(filter->xof));
+        filter->bits = 0;
+        filter->num_blocks = 0;
+        filter->k = 0;
+    }
+}
+
+void ascon_bloom_clear(ascon_bloom_filter_t *filter)
+{
+    memset(filter->bits, 0, filter->num_blocks * ASCON_BLOOM_BLOCK_SIZE);
+}
+
+void ascon_bloom_insert
+    (ascon_bloom_filter_t *filter, const unsigned char *in, size_t inlen)
+{
+    ascon_bloom_location_t loc;
+    ascon_bloom_locate(filter, &loc, in, inlen);
+    ascon_bloom_set(filter, &loc);
+}
+
+int ascon_bloom_contains
+    (const ascon_bloom_filter_t *filter, const unsigned char *in, size_t inlen)
+{
+    ascon_bloom_location_t loc;
+    ascon_bloom_locate(filter, &loc, in, inlen);
+    return ascon_bloom_test(filter, &loc);
+}
+
+void ascon_bloom_insert_batch
+    (ascon_bloom_filter_t *filter, const unsigned char * const *in,
+     const size_t *inlen, size_t count)
+{
+    ascon_bloom_location_t loc[ASCON_BLOOM_BATCH_SIZE];
+    size_t index, len;
+    while (count > 0) {
+        /* Locate all keys in the group and start fetching their blocks */
+        len = count;
+        if (len > ASCON_BLOOM_BATCH_SIZE)
+            len = ASCON_BLOOM_BATCH_SIZE;
+        for (index = 0; index < len; ++index) {
+            ascon_bloom_locate(filter, &(loc[index]), in[index], inlen[index]);
+            ascon_bloom_prefetch(loc[index].block);
+        }
+
+        /* Set the bits for all keys in the group */
+        for (index = 0; index < len; ++index)
+            ascon_bloom_set(filter, &(loc[index]));
+        in += len;
+        inlen += len;
+        count -= len;
+    }
+}
+
+size_t ascon_bloom_contains_batch
+    (const ascon_bloom_filter_t *filter, unsigned char *results,
+     const unsigned char * const *in, const size_t *inlen, size_t count)
+{
+    ascon_bloom_location_t loc[ASCON_BLOOM_BATCH_SIZE];
+    size_t index, len;
+    size_t found = 0;
+    while (count > 0) {
+        /* Locate all keys in the group and start fetching their blocks */
+        len = count;
+        if (len > ASCON_BLOOM_BATCH_SIZE)
+            len = ASCON_BLOOM_BATCH_SIZE;
+        for (index = 0; index < len; ++index) {
+            ascon_bloom_locate(filter, &(loc[index]), in[index], inlen[index]);
+            ascon_bloom_prefetch(loc[index].block);
+        }
+
+        /* Test the bits for all keys in the group */
+        for (index = 0; index < len; ++index) {
+            results[index] = (unsigned char)
+                ascon_bloom_test(filter, &(loc[index]));
+            found += results[index];
+        }
+        results += len;
+        in += len;
+        inlen += len;
+        count -= len;
+    }
+    return found;
+}
+
+int ascon_bloom_serialize
+    (const ascon_bloom_filter_t *filter, unsigned char *out, size_t outlen)
+{
+    size_t size = filter->num_blocks * ASCON_BLOOM_BLOCK_SIZE;
+    if (outlen < ASCON_BLOOM_HEADER_SIZE ||
+            (outlen - ASCON_BLOOM_HEADER_SIZE) < size)
+        return -1;
+    out[0] = 'A';
+    out[1] = 'S';
+    out[2] = 'B';
+    out[3] = 'F';
+    out[4] = ASCON_BLOOM_VERSION;
+    out[5] = (unsigned char)(filter->k);
+    out[6] = 0;
+    out[7] = 0;
+    be_store_word64(out + 8, (uint64_t)(filter->num_blocks));
+    memcpy(out + ASCON_BLOOM_HEADER_SIZE, filter->bits, size);
+    return 0;
+}
+
+int ascon_bloom_deserialize
+    (ascon_bloom_filter_t *filter, unsigned char *bits, size_t size,
+     const unsigned char *in, size_t inlen)
+{
+    uint64_t num_blocks;
+    if (inlen < ASCON_BLOOM_HEADER_SIZE)
+        return -1;
+    if (in[0] != 'A' || in[1] != 'S' || in[2] != 'B' || in[3] != 'F' ||
+            in[4] != ASCON_BLOOM_VERSION || in[6] != 0 || in[7] != 0)
+        return -1;
+    num_blocks = be_load_word64(in + 8);
+    inlen -= ASCON_BLOOM_HEADER_SIZE;
+    if ((inlen % ASCON_BLOOM_BLOCK_SIZE) != 0 ||
+            num_blocks != (inlen / ASCON_BLOOM_BLOCK_SIZE) || size < inlen)
+        return -1;
+    if (ascon_bloom_init(filter, bits, inlen, in[5]) < 0)
+        return -1;
+    memcpy(bits, in + ASCON_BLOOM_HEADER_SIZE, inlen);
+    return 0;
+}
@@ -0,0 +1,355 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <ascon/chunker.h>
+#include <ascon/utility.h>
+#include <string.h>
+
+/**
+ * \brief Table of random values for the gear rolling hash.
+ *
+ * The table is the first 2048 bytes of output from ASCON-cXOF with
+ * the function name "CDC", an empty customization string, and an
+ * empty input, loaded as big-endian 64-bit words.
+ */
+static uint64_t const ascon_chunker_gear[256] = {
+        0x1d2b266d86f3e8d3ULL, 0xcd36814c225c40a7ULL,
+        0xd771c0c3188b2377ULL, 0xad92f51633ea55bbULL,
+        0x61c3ed3b134a57bfULL, 0xe784c2e60d34352fULL,
+        0x44711722b5e377b9ULL, 0xbc0e05c05e490ce8ULL,
+        0x5fae7243e73246b8ULL, 0x6783ced7b9613e28ULL,
+        0xa0b3da6b3906792cULL, 0x243fbd49f6644c88ULL,
+        0x087f3aedc7e599b2ULL, 0x17d5b6a837834248ULL,
+        0xf0a60598317ad7faULL, 0xc699bc379c59127eULL,
+        0x5e95e50e7a354a9eULL, 0x95b7cd4cd95a5f4bULL,
+        0x7d2ff6a2f7e05710ULL, 0x31ede3fdd8f37cd7ULL,
+        0xe6d8d48fa8b12b47ULL, 0xbf92882ee37a65a1ULL,
+        0x498019d29762ab58ULL, 0x07420f5774434629ULL,
+        0x85160eef63051e90ULL, 0xb74117ad7dfd07ddULL,
+        0xaa48722493e69cedULL, 0xb49e2093075818e3ULL,
+        0xe6b0e69510c8aca3ULL, 0xa8b7ebee3af0fdd7ULL,
+        0x94c0a3ae895b42c7ULL, 0x718701c91064dd40ULL,
+        0x036cc04e4493ff32ULL, 0x3227a4e5497ac497ULL,
+        0x2c75ccc2e097821aULL, 0xc15db9a96e5195a3ULL,
+        0x3a42a614abe6b9c8ULL, 0xfee6dbc34b303071ULL,
+        0xa4e8473cff89efabULL, 0x6002afa3f7e5fb4bULL,
+        0x6c1ce1e6ac3bafa6ULL, 0xb5d6905e0445c559ULL,
+        0x2739ca7c64370c74ULL, 0xd9d566b7df41ca3cULL,
+        0xd946dca1467d8011ULL, 0x86b6ce5f31db0aa4ULL,
+        0x1ab15e0ec7736e86ULL, 0x1bd56389e4e59409ULL,
+        0x69b6cf344fab1b2fULL, 0x64527ce9843eb8d2ULL,
+        0xbdc4a114e31cc869ULL, 0x91cdb60209051da0ULL,
+        0x27fc02f85a1fc654ULL, 0xfbd9e2d4fa7dc754ULL,
+        0xd4c62db999f94e94ULL, 0xe6dd98050fd2a451ULL,
+        0x6b4d6784e09fb0adULL, 0xa5ee371c2b49cac3ULL,
+        0xe1891feb93d346feULL, 0x2088fa93b6af415cULL,
+        0x2d517c4aa0dc0b71ULL, 0x821b731c4378c06eULL,
+        0x255097b9ed72072aULL, 0xda91d159acb22bcaULL,
+        0xdb7e2330137993f7ULL, 0xbeb11ce778b4fd0bULL,
+        0x8548eee12b53ab1dULL, 0xc7f7dd4ad72f00a5ULL,
+        0x4546557f080e9ed7ULL, 0xa5ce3b69b89e5037ULL,
+        0x1b2d9733675ea31eULL, 0x73c9e0e11f3a3096ULL,
+        0xeee72b88dfa83db5ULL, 0x75db3602ee660087ULL,
+        0x468ce06a9874853bULL, 0xe7f9b00d6687d553ULL,
+        0x1da02ce8299fb733ULL, 0xd78d127c21cad162ULL,
+        0x6c0fca5339892602ULL, 0x4726b08da2a8b906ULL,
+        0xba5f707021cde3cdULL, 0xe39c5f6879d30689ULL,
+        0xacf8d99342287d84ULL, 0x77f9f25274825dd9ULL,
+        0xe36ecd21dc4efbc6ULL, 0xb9ec12bd1bef3155ULL,
+        0xd7f6c47dc174ea36ULL, 0x16c0fb2d9f89c922ULL,
+        0xba9ad3982f235dacULL, 0x93f04d8453289e5aULL,
+        0xc6df80bfded1317cULL, 0x33a395d0d8dabc81ULL,
+        0x08884e73bc48999aULL, 0xf2a07cda7ab4ee3aULL,
+        0xf14ce8637d0246d5ULL, 0xa3f6d77e525e7d03ULL,
+        0xb262422446b7e555ULL, 0x7df05d8bfbbae048ULL,
+        0x855e83e428e372c4ULL, 0xacd778c2cdc5ca3cULL,
+        0x47d54f2190c4fbadULL, 0x85502da9076d6875ULL,
+        0xc45a60b88c5042a9ULL, 0x0f46b93e8f8f226bULL,
+        0x6ba53f1c97d9dddfULL, 0xcd81d3271f850a92ULL,
+        0x8f9233f1a9061c78ULL, 0x8a5ed55f64806e2eULL,
+        0x1132eb75f9f900fdULL, 0xe35dade9bad56159ULL,
+        0xb1ce9373197cbb4fULL, 0x712e3d26bf228dafULL,
+        0x87f7f7158d61db4bULL, 0x8962a758d8188ec8ULL,
+        0xbbe738412d781eddULL, 0x4f0ad059b78050d4ULL,
+        0xc5cba1b6b635346bULL, 0x2d66d221d38cd843ULL,
+        0xb9bef236cc98524cULL, 0xa9bf45c9f60b6fa2ULL,
+        0xb33ef533801e5e0dULL, 0x5839d805048f3e7eULL,
+        0x37600a3e6f02b065ULL, 0x2fa60f54e65fa8f9ULL,
+        0x6efa019480dcb19aULL, 0x9c47ebdb01d3523dULL,
+        0xd0bf831f7ecd7bbcULL, 0x97429f3bb68c274cULL,
+        0x34e531a282261993ULL, 0x6b4bacc00b3202b3ULL,
+        0x0091730863b4f953ULL, 0xc38a6ca2da891ba8ULL,
+        0x0bfbf49af4ef4b31ULL, 0x6f30473f41c15013ULL,
+        0xa5428d6dfd845248ULL, 0xd05ac1b0c21781e9ULL,
+        0x504e6661597ddbe0ULL, 0x6bc205d3f116ebfbULL,
+        0x4a116d06f4e94c5dULL, 0xb46de7fddde641c4ULL,
+        0xee69fcdb0c0902a1ULL, 0x5a23d4273f4dd595ULL,
+        0xaf52f69c483c9e96ULL, 0x033361ead19fb15fULL,
+        0xdeb985c21072abb2ULL, 0x3c44e2663e2a47c9ULL,
+        0x30ce15ee7cc0ac33ULL, 0x74fb5be7930c3111ULL,
+        0x9020e82bf8d75662ULL, 0x07e77fc8cb3513e4ULL,
+        0x143e33758c76feb8ULL, 0x26780c02e770a9baULL,
+        0xef506e606f4542c1ULL, 0xdf49c888613ed95cULL,
+        0x19517f0951a64285ULL, 0x28d15b0c12480b97ULL,
+        0x0c305a104ec396daULL, 0xbbe88508ac76e99aULL,
+        0xcd73fac251ed9f52ULL, 0x888f52df6c82af45ULL,
+        0xcc9359e24b95d4dcULL, 0x546b0f9fa38c5c10ULL,
+        0xc1caf401304530cdULL, 0x05ceacb735d83c56ULL,
+        0xa0b1fc6aadc3977eULL, 0xa6e835c697e1bcceULL,
+        0x67cb798f00029824ULL, 0x19cc64d4f26a81c1ULL,
+        0x51b7cf4c5f2a9524ULL, 0x2147f9833c18ab0fULL,
+        0x0d505fc9da8434d4ULL, 0x7f32751df3c17336ULL,
+        0x75cfd5baa01dc6aaULL, 0xe34aca2344f9d8e7ULL,
+        0xe4abd0e014810172ULL, 0x0c23c2ab26111d95ULL,
+        0x0c75a32f8254f519ULL, 0x409587ba7e6c6f19ULL,
+        0xb4f597bc74da8ee2ULL, 0x24a328333e11517bULL,
+        0xac0a8ad766855d6aULL, 0x063a6e90febb7c07ULL,
+        0xb9175126599a8a7aULL, 0x310ba1bb9ccf2c00ULL,
+        0x19696546b3c1f48fULL, 0x5713c46bd018652aULL,
+        0xdfc63829207f3c41ULL, 0xd57217af3640e0ccULL,
+        0xf245916bd40a22ffULL, 0xbb2f1dd6acc20e3fULL,
+        0x450e79c38d820b35ULL, 0x125046e7308f35f6ULL,
+        0xdf82231764e084a4ULL, 0xcad6fc5e75edfc07ULL,
+        0xe8babed07bb46a0fULL, 0x970ffa932ef4c8bfULL,
+        0x8af7f9ec1ea78ec4ULL, 0x8f42a55e328d3d25ULL,
+        0x706fb4adecb49ee7ULL, 0x8ecc88e7b75360d2ULL,
+        0x7356b700941707efULL, 0xd07a7da8ff87d028ULL,
+        0xa6c281094c2756c6ULL, 0x463a2efe81671a3eULL,
+        0x1cea17b7a448fb1eULL, 0x47b977e475649ac3ULL,
+        0xcccfffd90300890dULL, 0x76669c4b00bdfb36ULL,
+        0xc6428121318ff37fULL, 0xc00bdf0a9ab696aaULL,
+        0xe7a193c4069b9fafULL, 0xd45e76299d91fa73ULL,
+        0x736e347722485f56ULL, 0xd399e3d1fc799a9aULL,
+        0x8179788533b0f049ULL, 0xe373c1903a975b18ULL,
+        0x9a3baad3d6d18beeULL, 0xc83f5653b839f4e4ULL,
+        0x270362480119e447ULL, 0xb0b30341330313dfULL,
+        0xacd9462dcf38c296ULL, 0x59b53b7fdebc68c6ULL,
+        0xb13cccc3ac1b951eULL, 0x9ee19e44cd10b818ULL,
+        0xa55f9a63494fadf2ULL, 0x3b5665d797db2799ULL,
+        0x70c333a0e620292bULL, 0xa1646cb8c76e477fULL,
+        0xe3b65f522acd3168ULL, 0xbfd63e5c03d53246ULL,
+        0xd717245024ce8cd3ULL, 0x7099484e9d642159ULL,
+        0xf6d51cffa4bc52f1ULL, 0x42829888f4e1f9fbULL,
+        0x6ef7dd47e74af61fULL, 0xadc6eab3384597c5ULL,
+        0x304b2c2c2b4d978dULL, 0x8828423e3fef739fULL,
+        0x2f187dd36b526e44ULL, 0xe24e5f4a6c5e228dULL,
+        0xac0dcb88d4cfc071ULL, 0x08036a7a9c850502ULL,
+        0x0ecd034f7a5113c0ULL, 0x818279e7c6d1d083ULL,
+        0xb26ad69a5916ecb6ULL, 0xdfe876a0b74d6af5ULL,
+        0xf08a612ecebc6e6eULL, 0x0e0a1c4b2275c419ULL,
+        0x48252eb899f1d577ULL, 0xf71686ef7b320da9ULL,
+        0x259dd5af3ff7b0c1ULL, 0xbcee78a3c24b8e4bULL,
+        0x944e458e355ba1e5ULL, 0x2de9849b49667231ULL,
+        0x9787a6c32c44cca3ULL, 0x388e796d2dc715a9ULL
+};
+
+/**
+ * \brief Makes a mask that selects the top bits of a fingerprint.
+ *
+ * \param bits Number of bits to select, between 1 and 63.
+ *
+ * \return The mask value.
+ *
+ * The high bits of the fingerprint are used because they are affected
+ * by the most recent 64 bytes of input with the left-shifting gear hash.
+ */
+static uint64_t ascon_chunker_mask(unsigned bits)
+{
+    if (bits < 1)
+        bits = 1;
+    else if (bits > 63)
+        bits = 63;
+    return ~((uint64_t)0) << (64 - bits);
+}
+
+/**
+ * \brief Initializes the common parts of the chunker state.
+ *
+ * \param state Chunker state to initialize.
+ * \param min_size Minimum size for chunks, or zero for the default.
+ * \param avg_size Average size for chunks, or zero for the default.
+ * \param max_size Maximum size for chunks, or zero for the default.
+ */
+static void ascon_chunker_init_common
+    (ascon_chunker_state_t *state, size_t min_size,
+     size_t avg_size, size_t max_size)
+{
+    unsigned bits;
+
+    /* Apply the defaults and then make sure the sizes are consistent */
+    if (!min_size)
+        min_size = ASCON_CHUNKER_MIN_SIZE;
+    if (!avg_size)
+        avg_size = ASCON_CHUNKER_AVG_SIZE;
+    if (!max_size)
+        max_size = ASCON_CHUNKER_MAX_SIZE;
+    bits = 0;
+    while ((((size_t)2) << bits) <= avg_size && bits < 62)
+        ++bits;
+    avg_size = ((size_t)1) << bits;
+    if (min_size > avg_size)
+        min_size = avg_size;
+    if (max_size < avg_size)
+        max_size = avg_size;
+
+    /* Normalized chunking: it is harder to find a boundary before the
+     * average size and easier afterwards, which narrows the spread of
+     * chunk sizes around the average */
+    state->fingerprint = 0;
+    state->mask_small = ascon_chunker_mask(bits + 2);
+    state->mask_large = ascon_chunker_mask(bits > 2 ? bits - 2 : 1);
+    state->offset = 0;
+    state->length = 0;
+    state->min_size = min_size;
+    state->avg_size = avg_size;
+    state->max_size = max_size;
+}
+
+void ascon_chunker_init
+    (ascon_chunker_state_t *state, size_t min_size,
+     size_t avg_size, size_t max_size)
+{
+    ascon_chunker_init_common(state, min_size, avg_size, max_size);
+    ascon_hash_init(&(state->h.hash));
+    state->hasha = 0;
+}
+
+void ascon_chunker_init_hasha
+    (ascon_chunker_state_t *state, size_t min_size,
+     size_t avg_size, size_t max_size)
+{
+    ascon_chunker_init_common(state, min_size, avg_size, max_size);
+    ascon_hasha_init(&(state->h.hasha));
+    state->hasha = 1;
+}
+
+void ascon_chunker_free(ascon_chunker_state_t *state)
+{
+    if (state) {
+        if (state->hasha)
+            ascon_hasha_free(&(state->h.hasha));
+        else
+            ascon_hash_free(&(state->h.hash));
+        ascon_clean(state, sizeof(ascon_chunker_state_t));
+    }
+}
+
+/**
+ * \brief Finishes off the current chunk and starts a new one.
+ *
+ * \param state Chunker state.
+ * \param chunk Returns information about the chunk that was finished.
+ */
+static void ascon_chunker_emit
+    (ascon_chunker_state_t *state, ascon_chunk_t *chunk)
+{
+    chunk->offset = state->offset;
+    chunk->length = state->length;
+    if (state->hasha) {
+        ascon_hasha_finalize(&(state->h.hasha), chunk->digest);
+        ascon_hasha_reinit(&(state->h.hasha));
+    } else {
+        ascon_hash_finalize(&(state->h.hash), chunk->digest);
+        ascon_hash_reinit(&(state->h.hash));
+    }
+    state->offset += state->length;
+    state->length = 0;
+    state->fingerprint = 0;
+}
+
+int ascon_chunker_update
+    (ascon_chunker_state_t *state, const unsigned char **in,
+     size_t *inlen, ascon_chunk_t *chunk)
+{
+    const unsigned char *data = *in;
+    size_t len = *inlen;
+    size_t posn = 0;
+    size_t length = state->length;
+    size_t limit = state->avg_size;
+    uint64_t fingerprint = state->fingerprint;
+    uint64_t mask = state->mask_small;
+    int found = 0;
+
+    /* Cut-point skipping: a boundary cannot occur before the minimum
+     * size, so there is no need to roll the gear hash over those bytes */
+    if (length < state->min_size) {
+        posn = state->min_size - length;
+        if (posn > len)
+            posn = len;
+        length += posn;
+    }
+
+    /* Roll the gear hash over the remaining bytes until we find a
+     * boundary or the chunk hits the maximum size */
+    if (length >= state->max_size) {
+        found = (length > 0);
+    } else {
+        if (length >= limit) {
+            mask = state->mask_large;
+            limit = state->max_size;
+        }
+        while (posn < len) {
+            fingerprint = (fingerprint << 1) +
+                          ascon_chunker_gear[data[posn++]];
+            ++length;
+            if (!(fingerprint & mask)) {
+                found = 1;
+                break;
+            }
+            if (length >= limit) {
+                if (length >= state->max_size) {
+                    found = 1;
+                    break;
+                }
+                mask = state->mask_large;
+                limit = state->max_size;
+            }
+        }
+    }
+
+    /* Hash all of the bytes that we consumed in a single request,
+     * which lets the hash absorb whole rate blocks at a time */
+    if (state->hasha)
+        ascon_hasha_update(&(state->h.hasha), data, posn);
+    else
+        ascon_hash_update(&(state->h.hash), data, posn);
+    state->length = length;
+    state->fingerprint = fingerprint;
+    *in = data + posn;
+    *inlen = len - posn;
+
+    /* Output the chunk if we found a boundary */
+    if (found)
+        ascon_chunker_emit(state, chunk);
+    return found;
+}
+
+int ascon_chunker_finalize
+    (ascon_chunker_state_t *state, ascon_chunk_t *chunk)
+{
+    int have_chunk = (state->length > 0);
+    if (have_chunk)
+        ascon_chunker_emit(state, chunk);
+    state->offset = 0;
+    return have_chunk;
+}
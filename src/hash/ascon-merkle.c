@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <ascon/merkle.h>
+#include "aead/ascon-aead-common.h"
+#include <string.h>
+
+/** Domain separation prefix for leaf hashes */
+#define ASCON_MERKLE_LEAF 0x00
+
+/** Domain separation prefix for interior node hashes */
+#define ASCON_MERKLE_NODE 0x01
+
+/** Gets a pointer to a specific node in the node array */
+#define ASCON_MERKLE_NODE_PTR(nodes, index) \
+    ((nodes) + (index) * ASCON_MERKLE_HASH_SIZE)
+
+/**
+ * \brief Hashes a prefix byte followed by a block of data.
+ *
+ * \param hasha Non-zero to use ASCON-HASHA, zero for ASCON-HASH.
+ * \param out Buffer to receive the hash value.
+ * \param prefix The domain separation prefix byte.
+ * \param data Points to the data to be hashed.
+ * \param len Length of the data in bytes.
+ */
+static void ascon_merkle_hash
+    (int hasha, unsigned char *out, unsigned char prefix,
+     const unsigned char *data, size_t len)
+{
+    if (hasha) {
+        ascon_hasha_state_t state;
+        ascon_hasha_init(&state);
+        ascon_hasha_update(&state, &prefix, 1);
+        ascon_hasha_update(&state, data, len);
+        ascon_hasha_finalize(&state, out);
+        ascon_hasha_free(&state);
+    } else {
+        ascon_hash_state_t state;
+        ascon_hash_init(&state);
+        ascon_hash_update(&state, &prefix, 1);
+        ascon_hash_update(&state, data, len);
+        ascon_hash_finalize(&state, out);
+        ascon_hash_free(&state);
+    }
+}
+
+/**
+ * \brief Recomputes the hash of an interior node from its children.
+ *
+ * \param tree The tree.
+ * \param index Index of the interior node to recompute.
+ *
+ * The children of node i are 2i and 2i + 1, which are adjacent in the
+ * node array and so can be hashed directly from the array.
+ */
+static void ascon_merkle_rehash(ascon_merkle_tree_t *tree, size_t index)
+{
+    ascon_merkle_hash
+        (tree->hasha, ASCON_MERKLE_NODE_PTR(tree->nodes, index),
+         ASCON_MERKLE_NODE, ASCON_MERKLE_NODE_PTR(tree->nodes, index * 2),
+         ASCON_MERKLE_HASH_SIZE * 2);
+}
+
+/**
+ * \brief Initializes an empty Merkle tree.
+ *
+ * \param tree The tree to initialize.
+ * \param nodes Points to the node array.
+ * \param capacity The number of leaves in the tree.
+ * \param hasha Non-zero to use ASCON-HASHA, zero for ASCON-HASH.
+ *
+ * \return Zero on success or -1 if \a capacity is not a power of two.
+ */
+static int ascon_merkle_init_common
+    (ascon_merkle_tree_t *tree, unsigned char *nodes,
+     size_t capacity, int hasha)
+{
+    size_t first, index;
+    unsigned depth = 0;
+
+    /* Validate the capacity */
+    if (!capacity || (capacity & (capacity - 1)) != 0)
+        return -1;
+    while ((((size_t)1) << depth) < capacity)
+        ++depth;
+    tree->nodes = nodes;
+    tree->capacity = capacity;
+    tree->depth = depth;
+    tree->hasha = (unsigned char)(hasha != 0);
+
+    /* All leaves start as zero.  Every node on a level has the same
+     * value in an empty tree, so we only need one hash per level */
+    memset(ASCON_MERKLE_NODE_PTR(nodes, capacity), 0,
+           capacity * ASCON_MERKLE_HASH_SIZE);
+    for (first = capacity / 2; first >= 1; first /= 2) {
+        ascon_merkle_rehash(tree, first);
+        for (index = first + 1; index < first * 2; ++index) {
+            memcpy(ASCON_MERKLE_NODE_PTR(nodes, index),
+                   ASCON_MERKLE_NODE_PTR(nodes, first),
+                   ASCON_MERKLE_HASH_SIZE);
+        }
+    }
+    return 0;
+}
+
+int ascon_merkle_init
+    (ascon_merkle_tree_t *tree, unsigned char *nodes, size_t capacity)
+{
+    return ascon_merkle_init_common(tree, nodes, capacity, 0);
+}
+
+int ascon_merkle_init_hasha
+    (ascon_merkle_tree_t *tree, unsigned char *nodes, size_t capacity)
+{
+    return ascon_merkle_init_common(tree, nodes, capacity, 1);
+}
+
+const unsigned char *ascon_merkle_root(const ascon_merkle_tree_t *tree)
+{
+    return ASCON_MERKLE_NODE_PTR(tree->nodes, 1);
+}
+
+int ascon_merkle_set_leaf
+    (ascon_merkle_tree_t *tree, size_t index,
+     const unsigned char *data, size_t len)
+{
+    if (index >= tree->capacity)
+        return -1;
+    index += tree->capacity;
+    ascon_merkle_hash
+        (tree->hasha, ASCON_MERKLE_NODE_PTR(tree->nodes, index),
+         ASCON_MERKLE_LEAF, data, len);
+    for (index /= 2; index >= 1; index /= 2)
+        ascon_merkle_rehash(tree, index);
+    return 0;
+}
+
+int ascon_merkle_set_leaves
+    (ascon_merkle_tree_t *tree, const size_t *indices,
+     const unsigned char * const *data, const size_t *lens, size_t count)
+{
+    size_t posn, node, prev;
+    unsigned level;
+
+    /* Validate the indices before we modify anything */
+    for (posn = 0; posn < count; ++posn) {
+        if (indices[posn] >= tree->capacity)
+            return -1;
+        if (posn > 0 && indices[posn] <= indices[posn - 1])
+            return -1;
+    }
+
+    /* Hash the new leaf values */
+    for (posn = 0; posn < count; ++posn) {
+        node = tree->capacity + indices[posn];
+        ascon_merkle_hash
+            (tree->hasha, ASCON_MERKLE_NODE_PTR(tree->nodes, node),
+             ASCON_MERKLE_LEAF, data[posn], lens[posn]);
+    }
+
+    /* Rehash the ancestors one level at a time.  Because the indices are
+     * sorted, the ancestors on each level are also sorted and any shared
+     * ancestors will be adjacent in the sequence, so we can skip them */
+    for (level = 1; level <= tree->depth && count > 0; ++level) {
+        prev = 0;
+        for (posn = 0; posn < count; ++posn) {
+            node = (tree->capacity + indices[posn]) >> level;
+            if (node != prev) {
+                ascon_merkle_rehash(tree, node);
+                prev = node;
+            }
+        }
+    }
+    return 0;
+}
+
+int ascon_merkle_get_proof
+    (const ascon_merkle_tree_t *tree, size_t index, unsigned char *proof)
+{
+    if (index >= tree->capacity)
+        return -1;
+    for (index += tree->capacity; index > 1; index /= 2) {
+        memcpy(proof, ASCON_MERKLE_NODE_PTR(tree->nodes, index ^ 1),
+               ASCON_MERKLE_HASH_SIZE);
+        proof += ASCON_MERKLE_HASH_SIZE;
+    }
+    return 0;
+}
+
+/**
+ * \brief Verifies an inclusion proof for a leaf in a Merkle tree.
+ *
+ * \param hasha Non-zero to use ASCON-HASHA, zero for ASCON-HASH.
+ * \param root Points to the expected root hash.
+ * \param index Index of the leaf in the tree.
+ * \param depth Depth of the tree.
+ * \param data Points to the data for the leaf.
+ * \param len Length of the leaf data in bytes.
+ * \param proof Points to the proof.
+ *
+ * \return Zero if the proof is valid or -1 if it is not.
+ */
+static int ascon_merkle_verify_common
+    (int hasha, const unsigned char *root, size_t index, unsigned depth,
+     const unsigned char *data, size_t len, const unsigned char *proof)
+{
+    unsigned char pair[ASCON_MERKLE_HASH_SIZE * 2];
+    unsigned char hash[ASCON_MERKLE_HASH_SIZE];
+    unsigned level;
+
+    /* The index must fit within a tree of the given depth */
+    if (depth >= sizeof(size_t) * 8 || (index >> depth) != 0)
+        return -1;
+
+    /* Hash the leaf and then walk up the tree to the root */
+    ascon_merkle_hash(hasha, hash, ASCON_MERKLE_LEAF, data, len);
+    for (level = 0; level < depth; ++level) {
+        if (index & 1) {
+            memcpy(pair, proof, ASCON_MERKLE_HASH_SIZE);
+            memcpy(pair + ASCON_MERKLE_HASH_SIZE, hash, ASCON_MERKLE_HASH_SIZE);
+        } else {
+            memcpy(pair, hash, ASCON_MERKLE_HASH_SIZE);
+            memcpy(pair + ASCON_MERKLE_HASH_SIZE, proof, ASCON_MERKLE_HASH_SIZE);
+        }
+        ascon_merkle_hash(hasha, hash, ASCON_MERKLE_NODE, pair, sizeof(pair));
+        proof += ASCON_MERKLE_HASH_SIZE;
+        index >>= 1;
+    }
+
+    /* Compare the computed root with the expected root */
+    return ascon_aead_check_tag(0, 0, hash, root, ASCON_MERKLE_HASH_SIZE);
+}
+
+int ascon_merkle_verify
+    (const unsigned char *root, size_t index, unsigned depth,
+     const unsigned char *data, size_t len, const unsigned char *proof)
+{
+    return ascon_merkle_verify_common
+        (0, root, index, depth, data, len, proof);
+}
+
+int ascon_merkle_verify_hasha
+    (const unsigned char *root, size_t index, unsigned depth,
+     const unsigned char *data, size_t len, const unsigned char *proof)
+{
+    return ascon_merkle_verify_common
+        (1, root, index, depth, data, len, proof);
+}
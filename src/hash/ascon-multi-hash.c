@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <ascon/multi-hash.h>
+#include "core/ascon-util-snp.h"
+#include <string.h>
+
+/**
+ * \brief Maximum number of lanes in a multi-hash state.
+ */
+#define ASCON_MULTI_HASH_MAX_LANES 4
+
+/**
+ * \brief Size of the input window that is absorbed into every lane
+ * before moving onto the next window.
+ */
+#define ASCON_MULTI_HASH_WINDOW 1024
+
+/**
+ * \brief Information about the active lanes in a multi-hash state.
+ */
+typedef struct
+{
+    ascon_state_t *state[ASCON_MULTI_HASH_MAX_LANES]; /**< Lane states */
+    uint8_t first_round[ASCON_MULTI_HASH_MAX_LANES];  /**< Absorb rounds */
+    unsigned count;                                   /**< Active lanes */
+
+} ascon_multi_hash_lanes_t;
+
+/**
+ * \brief Collects the permutation states of the active algorithms.
+ *
+ * \param state Multi-hash state.
+ * \param lanes Returns the lane information.
+ */
+static void ascon_multi_hash_get_lanes
+    (ascon_multi_hash_state_t *state, ascon_multi_hash_lanes_t *lanes)
+{
+    unsigned count = 0;
+    if (state->algorithms & ASCON_MULTI_HASH) {
+        lanes->state[count] = &(state->hash.xof.state);
+        lanes->first_round[count++] = 0;
+    }
+    if (state->algorithms & ASCON_MULTI_HASHA) {
+        lanes->state[count] = &(state->hasha.xof.state);
+        lanes->first_round[count++] = 4;
+    }
+    if (state->algorithms & ASCON_MULTI_XOF) {
+        lanes->state[count] = &(state->xof.state);
+        lanes->first_round[count++] = 0;
+    }
+    if (state->algorithms & ASCON_MULTI_XOFA) {
+        lanes->state[count] = &(state->xofa.state);
+        lanes->first_round[count++] = 4;
+    }
+    lanes->count = count;
+}
+
+void ascon_multi_hash_init
+    (ascon_multi_hash_state_t *state, unsigned algorithms)
+{
+    memset(state, 0, sizeof(ascon_multi_hash_state_t));
+    state->algorithms = (unsigned char)
+        (algorithms & (ASCON_MULTI_HASH | ASCON_MULTI_HASHA |
+                       ASCON_MULTI_XOF | ASCON_MULTI_XOFA));
+    state->count = 0;
+    if (state->algorithms & ASCON_MULTI_HASH)
+        ascon_hash_init(&(state->hash));
+    if (state->algorithms & ASCON_MULTI_HASHA)
+        ascon_hasha_init(&(state->hasha));
+    if (state->algorithms & ASCON_MULTI_XOF)
+        ascon_xof_init(&(state->xof));
+    if (state->algorithms & ASCON_MULTI_XOFA)
+        ascon_xofa_init(&(state->xofa));
+}
+
+void ascon_multi_hash_free(ascon_multi_hash_state_t *state)
+{
+    if (state) {
+        if (state->algorithms & ASCON_MULTI_HASH)
+            ascon_hash_free(&(state->hash));
+        if (state->algorithms & ASCON_MULTI_HASHA)
+            ascon_hasha_free(&(state->hasha));
+        if (state->algorithms & ASCON_MULTI_XOF)
+            ascon_xof_free(&(state->xof));
+        if (state->algorithms & ASCON_MULTI_XOFA)
+            ascon_xofa_free(&(state->xofa));
+        state->algorithms = 0;
+        state->count = 0;
+    }
+}
+
+/**
+ * \brief Absorbs a window of input data into a single lane.
+ *
+ * \param state Permutation state for the lane.
+ * \param first_round First round of the permutation to use when absorbing.
+ * \param in Points to the input data.
+ * \param inlen Length of the input data.
+ * \param count Number of bytes already absorbed into the current block.
+ *
+ * \return The new number of bytes in the current block.
+ */
+static unsigned ascon_multi_hash_absorb_lane
+    (ascon_state_t *state, uint8_t first_round,
+     const unsigned char *in, size_t inlen, unsigned count)
+{
+    unsigned temp;
+
+    /* Acquire access to shared hardware if necessary */
+    ascon_acquire(state);
+
+    /* Handle the partial left-over block from last time */
+    if (count) {
+        temp = ASCON_XOF_RATE - count;
+        if (temp > inlen) {
+            temp = (unsigned)inlen;
+            ascon_absorb_partial(state, in, count, temp);
+            ascon_release(state);
+            return count + temp;
+        }
+        ascon_absorb_partial(state, in, count, temp);
+        ascon_permute(state, first_round);
+        in += temp;
+        inlen -= temp;
+    }
+
+    /* Process as many full blocks as possible */
+    while (inlen >= ASCON_XOF_RATE) {
+        ascon_absorb_8(state, in, 0);
+        ascon_permute(state, first_round);
+        in += ASCON_XOF_RATE;
+        inlen -= ASCON_XOF_RATE;
+    }
+
+    /* Absorb the left-over block at the end of the input */
+    temp = (unsigned)inlen;
+    if (temp > 0)
+        ascon_absorb_partial(state, in, 0, temp);
+
+    /* Release access to the shared hardware */
+    ascon_release(state);
+    return temp;
+}
+
+void ascon_multi_hash_update
+    (ascon_multi_hash_state_t *state, const unsigned char *in, size_t inlen)
+{
+    ascon_multi_hash_lanes_t lanes;
+    unsigned lane, next_count;
+    unsigned count = state->count;
+    size_t len;
+
+    /* Split the input into windows that are small enough to stay in the
+     * cache while every lane absorbs them.  Only one lane is acquired at
+     * a time because some backends have a single hardware state. */
+    ascon_multi_hash_get_lanes(state, &lanes);
+    while (inlen > 0) {
+        len = inlen;
+        if (len > ASCON_MULTI_HASH_WINDOW)
+            len = ASCON_MULTI_HASH_WINDOW;
+        next_count = count;
+        for (lane = 0; lane < lanes.count; ++lane) {
+            next_count = ascon_multi_hash_absorb_lane
+                (lanes.state[lane], lanes.first_round[lane], in, len, count);
+        }
+        count = next_count;
+        in += len;
+        inlen -= len;
+    }
+
+    /* Keep the per-algorithm block counts in sync with the shared count */
+    if (lanes.count > 0) {
+        state->count = (unsigned char)count;
+        state->hash.xof.count = (unsigned char)count;
+        state->hasha.xof.count = (unsigned char)count;
+        state->xof.count = (unsigned char)count;
+        state->xofa.count = (unsigned char)count;
+    }
+}
+
+void ascon_multi_hash_finalize_hash
+    (ascon_multi_hash_state_t *state, unsigned char *out)
+{
+    ascon_hash_finalize(&(state->hash), out);
+}
+
+void ascon_multi_hash_finalize_hasha
+    (ascon_multi_hash_state_t *state, unsigned char *out)
+{
+    ascon_hasha_finalize(&(state->hasha), out);
+}
+
+void ascon_multi_hash_squeeze_xof
+    (ascon_multi_hash_state_t *state, unsigned char *out, size_t outlen)
+{
+    ascon_xof_squeeze(&(state->xof), out, outlen);
+}
+
+void ascon_multi_hash_squeeze_xofa
+    (ascon_multi_hash_state_t *state, unsigned char *out, size_t outlen)
+{
+    ascon_xofa_squeeze(&(state->xofa), out, outlen);
+}
@@ -49,6 +49,34 @@ void ascon_xof_absorb_custom
 void ascon_xofa_absorb_custom
     (ascon_xofa_state_t *state, const unsigned char *custom, size_t customlen);
 
+/**
+ * \brief Absorbs and then squeezes data on copies of two ASCON-XOF states.
+ *
+ * \param base1 The first base XOF state to copy.
+ * \param out1 Output buffer for the copy of \a base1.
+ * \param in1 Input data for the copy of \a base1.
+ * \param base2 The second base XOF state to copy, which may be the
+ * same as \a base1.
+ * \param out2 Output buffer for the copy of \a base2.
+ * \param in2 Input data for the copy of \a base2.
+ * \param inlen Number of bytes to absorb into each copy.
+ * \param outlen Number of bytes to squeeze out of each copy.
+ *
+ * Both base states must be in the absorb phase on a block boundary.
+ * They are not modified.
+ *
+ * The result is the same as copying each base state and calling
+ * ascon_xof_absorb() and ascon_xof_squeeze() on the copies.  On backends
+ * that support it, the permutation calls for the two copies are
+ * interleaved.  The output buffers may be the same as the input buffers.
+ */
+void ascon_xof_absorb_squeeze_2way
+    (const ascon_xof_state_t *base1,
+     unsigned char *out1, const unsigned char *in1,
+     const ascon_xof_state_t *base2,
+     unsigned char *out2, const unsigned char *in2,
+     size_t inlen, size_t outlen);
+
 #ifdef __cplusplus
 }
 #endif
@@ -21,8 +21,10 @@
  */
 
 #include <ascon/xof.h>
+#include <ascon/utility.h>
 #include "core/ascon-util-snp.h"
 #include "hash/ascon-xof-internal.h"
+#include "core/ascon-permute-2way.h"
 #include <string.h>
 
 void ascon_xof(unsigned char *out, const unsigned char *in, size_t inlen)
@@ -351,3 +353,93 @@ void ascon_xof_copy(ascon_xof_state_t *dest, const ascon_xof_state_t *src)
         dest->mode = src->mode;
     }
 }
+
+void ascon_xof_precompute
+    (ascon_xof_precomputed_t *pre, const char *function_name,
+     const unsigned char *custom, size_t customlen, size_t outlen)
+{
+    ascon_xof_init_custom
+        (&(pre->xof), function_name, custom, customlen, outlen);
+}
+
+void ascon_xof_init_precomputed
+    (ascon_xof_state_t *state, const ascon_xof_precomputed_t *pre)
+{
+    ascon_xof_copy(state, &(pre->xof));
+}
+
+void ascon_xof_reinit_precomputed
+    (ascon_xof_state_t *state, const ascon_xof_precomputed_t *pre)
+{
+#if defined(ASCON_BACKEND_SLICED64) || defined(ASCON_BACKEND_SLICED32) || \
+        defined(ASCON_BACKEND_DIRECT_XOR)
+    ascon_xof_init_precomputed(state, pre);
+#else
+    ascon_xof_free(state);
+    ascon_xof_init_precomputed(state, pre);
+#endif
+}
+
+void ascon_xof_precomputed_free(ascon_xof_precomputed_t *pre)
+{
+    if (pre)
+        ascon_xof_free(&(pre->xof));
+}
+
+void ascon_xof_absorb_squeeze_2way
+    (const ascon_xof_state_t *base1,
+     unsigned char *out1, const unsigned char *in1,
+     const ascon_xof_state_t *base2,
+     unsigned char *out2, const unsigned char *in2,
+     size_t inlen, size_t outlen)
+{
+#if defined(ASCON_PERMUTE_2WAY)
+    ascon_state_t state1;
+    ascon_state_t state2;
+    size_t posn;
+    unsigned temp;
+
+    /* The state is five plain words on this backend, so we can copy it */
+    memcpy(&state1, &(base1->state), sizeof(ascon_state_t));
+    memcpy(&state2, &(base2->state), sizeof(ascon_state_t));
+
+    /* Absorb all of the input before squeezing in case in == out */
+    for (posn = 0; (inlen - posn) >= ASCON_XOF_RATE; posn += ASCON_XOF_RATE) {
+        ascon_absorb_8(&state1, in1 + posn, 0);
+        ascon_absorb_8(&state2, in2 + posn, 0);
+        ascon_permute_2way(&state1, &state2, 0);
+    }
+    temp = (unsigned)(inlen - posn);
+    if (temp > 0) {
+        ascon_absorb_partial(&state1, in1 + posn, 0, temp);
+        ascon_absorb_partial(&state2, in2 + posn, 0, temp);
+    }
+    ascon_pad(&state1, temp);
+    ascon_pad(&state2, temp);
+
+    /* Squeeze the output */
+    for (posn = 0; (outlen - posn) >= ASCON_XOF_RATE; posn += ASCON_XOF_RATE) {
+        ascon_permute_2way(&state1, &state2, 0);
+        ascon_squeeze_8(&state1, out1 + posn, 0);
+        ascon_squeeze_8(&state2, out2 + posn, 0);
+    }
+    temp = (unsigned)(outlen - posn);
+    if (temp > 0) {
+        ascon_permute_2way(&state1, &state2, 0);
+        ascon_squeeze_partial(&state1, out1 + posn, 0, temp);
+        ascon_squeeze_partial(&state2, out2 + posn, 0, temp);
+    }
+    ascon_clean(&state1, sizeof(state1));
+    ascon_clean(&state2, sizeof(state2));
+#else
+    ascon_xof_state_t state;
+    ascon_xof_copy(&state, base1);
+    ascon_xof_absorb(&state, in1, inlen);
+    ascon_xof_squeeze(&state, out1, outlen);
+    ascon_xof_free(&state);
+    ascon_xof_copy(&state, base2);
+    ascon_xof_absorb(&state, in2, inlen);
+    ascon_xof_squeeze(&state, out2, outlen);
+    ascon_xof_free(&state);
+#endif
+}
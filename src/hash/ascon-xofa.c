@@ -350,3 +350,35 @@ void ascon_xofa_copy(ascon_xofa_state_t *dest, const ascon_xofa_state_t *src)
         dest->mode = src->mode;
     }
 }
+
+void ascon_xofa_precompute
+    (ascon_xofa_precomputed_t *pre, const char *function_name,
+     const unsigned char *custom, size_t customlen, size_t outlen)
+{
+    ascon_xofa_init_custom
+        (&(pre->xof), function_name, custom, customlen, outlen);
+}
+
+void ascon_xofa_init_precomputed
+    (ascon_xofa_state_t *state, const ascon_xofa_precomputed_t *pre)
+{
+    ascon_xofa_copy(state, &(pre->xof));
+}
+
+void ascon_xofa_reinit_precomputed
+    (ascon_xofa_state_t *state, const ascon_xofa_precomputed_t *pre)
+{
+#if defined(ASCON_BACKEND_SLICED64) || defined(ASCON_BACKEND_SLICED32) || \
+        defined(ASCON_BACKEND_DIRECT_XOR)
+    ascon_xofa_init_precomputed(state, pre);
+#else
+    ascon_xofa_free(state);
+    ascon_xofa_init_precomputed(state, pre);
+#endif
+}
+
+void ascon_xofa_precomputed_free(ascon_xofa_precomputed_t *pre)
+{
+    if (pre)
+        ascon_xofa_free(&(pre->xof));
+}
@@ -34,6 +34,16 @@
  * HKDF_HMAC_UPDATE     Name of the HMAC update function.
  * HKDF_HMAC_FINALIZE   Name of the HMAC finalization function.
  * HKDF_HMAC_FREE       Name of the HMAC free function.
+ * HKDF_CONTEXT         Type for the HKDF context; e.g. ascon_hkdf_context_t
+ *                      (optional; omits the context API if absent)
+ * HKDF_HMAC_KEY_INIT   Name of the HMAC key context initialization function.
+ * HKDF_HMAC_KEY_FREE   Name of the HMAC key context free function.
+ * HKDF_HMAC_INIT_PRECOMPUTED Name of the HMAC function to initialize
+ *                      from a key context.
+ * HKDF_HMAC_FINALIZE_PRECOMPUTED Name of the HMAC function to finalize
+ *                      with a key context.
+ * HKDF_XOF_2WAY        Name of the function to absorb and squeeze two XOF
+ *                      states side by side (optional).
  */
 #if defined(HKDF_ALG_NAME)
 
@@ -122,6 +132,180 @@ void HKDF_CONCAT(HKDF_ALG_NAME,_free)(HKDF_STATE *state)
     ascon_clean(state, sizeof(HKDF_STATE));
 }
 
+#if defined(HKDF_CONTEXT)
+
+/* Maximum info length for expanding two labels side by side */
+#define HKDF_LANE_INFO_MAX 64
+
+void HKDF_CONCAT(HKDF_ALG_NAME,_context_init)
+    (HKDF_CONTEXT *context,
+     const unsigned char *key, size_t keylen,
+     const unsigned char *salt, size_t saltlen)
+{
+    HKDF_STATE state;
+    HKDF_CONCAT(HKDF_ALG_NAME,_extract)(&state, key, keylen, salt, saltlen);
+    HKDF_HMAC_KEY_INIT(&(context->prk), state.prk, sizeof(state.prk));
+    ascon_clean(&state, sizeof(state));
+}
+
+void HKDF_CONCAT(HKDF_ALG_NAME,_context_free)(HKDF_CONTEXT *context)
+{
+    if (context)
+        HKDF_HMAC_KEY_FREE(&(context->prk));
+}
+
+/*
+ * Expands the rest of a label one block at a time.  T contains the
+ * previous output block, counter is the number of the next block,
+ * and posn is the position in the label's output buffer.
+ */
+static void HKDF_CONCAT(HKDF_ALG_NAME,_context_label)
+    (const HKDF_CONTEXT *context, const ascon_hkdf_label_t *label,
+     unsigned char *T, unsigned char counter, size_t posn)
+{
+    HKDF_HMAC_STATE hmac;
+    size_t len;
+    while (posn < label->outlen) {
+        HKDF_HMAC_INIT_PRECOMPUTED(&hmac, &(context->prk));
+        if (counter != 1)
+            HKDF_HMAC_UPDATE(&hmac, T, HKDF_HMAC_SIZE);
+        HKDF_HMAC_UPDATE(&hmac, label->info, label->infolen);
+        HKDF_HMAC_UPDATE(&hmac, &counter, 1);
+        HKDF_HMAC_FINALIZE_PRECOMPUTED(&hmac, &(context->prk), T);
+        HKDF_HMAC_FREE(&hmac);
+        ++counter;
+        len = label->outlen - posn;
+        if (len > HKDF_HMAC_SIZE)
+            len = HKDF_HMAC_SIZE;
+        memcpy(label->out + posn, T, len);
+        posn += len;
+    }
+}
+
+#if defined(HKDF_XOF_2WAY)
+
+/*
+ * Expands two labels with the same info length side by side.  The blocks
+ * of the two labels are independent, so the inner and outer hashes for
+ * both labels are computed with interleaved permutation calls.  T must
+ * be 2 * HKDF_HMAC_SIZE bytes in size.
+ */
+static void HKDF_CONCAT(HKDF_ALG_NAME,_context_label_2way)
+    (const HKDF_CONTEXT *context, const ascon_hkdf_label_t *label1,
+     const ascon_hkdf_label_t *label2, unsigned char *T)
+{
+    unsigned char msg1[HKDF_HMAC_SIZE + HKDF_LANE_INFO_MAX + 1];
+    unsigned char msg2[HKDF_HMAC_SIZE + HKDF_LANE_INFO_MAX + 1];
+    unsigned char *T2 = T + HKDF_HMAC_SIZE;
+    size_t infolen = label1->infolen;
+    size_t msglen, len;
+    size_t posn = 0;
+    unsigned char counter = 1;
+    while (posn < label1->outlen && posn < label2->outlen) {
+        /* Format the messages as T(i - 1) || info || i */
+        if (counter == 1) {
+            msglen = 0;
+        } else {
+            memcpy(msg1, T, HKDF_HMAC_SIZE);
+            memcpy(msg2, T2, HKDF_HMAC_SIZE);
+            msglen = HKDF_HMAC_SIZE;
+        }
+        memcpy(msg1 + msglen, label1->info, infolen);
+        memcpy(msg2 + msglen, label2->info, infolen);
+        msglen += infolen;
+        msg1[msglen] = counter;
+        msg2[msglen] = counter;
+        ++msglen;
+
+        /* Run the inner and then the outer hashes for both labels */
+        HKDF_XOF_2WAY(&(context->prk.inner.hash.xof), T, msg1,
+                      &(context->prk.inner.hash.xof), T2, msg2,
+                      msglen, HKDF_HMAC_SIZE);
+        HKDF_XOF_2WAY(&(context->prk.outer.hash.xof), T, T,
+                      &(context->prk.outer.hash.xof), T2, T2,
+                      HKDF_HMAC_SIZE, HKDF_HMAC_SIZE);
+        ++counter;
+
+        /* Copy the blocks to the output buffers */
+        len = label1->outlen - posn;
+        if (len > HKDF_HMAC_SIZE)
+            len = HKDF_HMAC_SIZE;
+        memcpy(label1->out + posn, T, len);
+        len = label2->outlen - posn;
+        if (len > HKDF_HMAC_SIZE)
+            len = HKDF_HMAC_SIZE;
+        memcpy(label2->out + posn, T2, len);
+        posn += HKDF_HMAC_SIZE;
+    }
+
+    /* Finish the longer label on its own */
+    HKDF_CONCAT(HKDF_ALG_NAME,_context_label)
+        (context, label1, T, counter, posn);
+    HKDF_CONCAT(HKDF_ALG_NAME,_context_label)
+        (context, label2, T2, counter, posn);
+    ascon_clean(msg1, sizeof(msg1));
+    ascon_clean(msg2, sizeof(msg2));
+}
+
+#endif /* HKDF_XOF_2WAY */
+
+int HKDF_CONCAT(HKDF_ALG_NAME,_context_expand)
+    (const HKDF_CONTEXT *context,
+     const unsigned char *info, size_t infolen,
+     unsigned char *out, size_t outlen)
+{
+    ascon_hkdf_label_t label;
+    label.info = info;
+    label.infolen = infolen;
+    label.out = out;
+    label.outlen = outlen;
+    return HKDF_CONCAT(HKDF_ALG_NAME,_context_expand_labels)
+        (context, &label, 1);
+}
+
+int HKDF_CONCAT(HKDF_ALG_NAME,_context_expand_labels)
+    (const HKDF_CONTEXT *context,
+     const ascon_hkdf_label_t *labels, size_t count)
+{
+    unsigned char T[HKDF_HMAC_SIZE * 2];
+    size_t index;
+
+    /* Validate all of the output lengths before generating anything */
+    for (index = 0; index < count; ++index) {
+        if (labels[index].outlen > (size_t)(HKDF_HMAC_SIZE * 255))
+            return -1;
+    }
+
+    /* Expand pairs of labels side by side if their info lengths match */
+    index = 0;
+#if defined(HKDF_XOF_2WAY)
+    while ((count - index) >= 2) {
+        if (labels[index].infolen == labels[index + 1].infolen &&
+                labels[index].infolen <= HKDF_LANE_INFO_MAX) {
+            HKDF_CONCAT(HKDF_ALG_NAME,_context_label_2way)
+                (context, &(labels[index]), &(labels[index + 1]), T);
+            index += 2;
+        } else {
+            HKDF_CONCAT(HKDF_ALG_NAME,_context_label)
+                (context, &(labels[index]), T, 1, 0);
+            ++index;
+        }
+    }
+#endif
+
+    /* Expand the remaining labels one at a time */
+    for (; index < count; ++index) {
+        HKDF_CONCAT(HKDF_ALG_NAME,_context_label)
+            (context, &(labels[index]), T, 1, 0);
+    }
+    ascon_clean(T, sizeof(T));
+    return 0;
+}
+
+#undef HKDF_LANE_INFO_MAX
+
+#endif /* HKDF_CONTEXT */
+
 #endif /* HKDF_ALG_NAME */
 
 /* Now undefine everything so that we can include this file again for
@@ -134,3 +318,9 @@ void HKDF_CONCAT(HKDF_ALG_NAME,_free)(HKDF_STATE *state)
 #undef HKDF_HMAC_UPDATE
 #undef HKDF_HMAC_FINALIZE
 #undef HKDF_HMAC_FREE
+#undef HKDF_CONTEXT
+#undef HKDF_HMAC_KEY_INIT
+#undef HKDF_HMAC_KEY_FREE
+#undef HKDF_HMAC_INIT_PRECOMPUTED
+#undef HKDF_HMAC_FINALIZE_PRECOMPUTED
+#undef HKDF_XOF_2WAY
@@ -24,6 +24,7 @@
 #include <ascon/hmac.h>
 #include <ascon/utility.h>
 #include "core/ascon-util.h"
+#include "hash/ascon-xof-internal.h"
 #include <string.h>
 
 /* The actual implementation is in the "ascon-hkdf-common.h" file */
@@ -37,4 +38,10 @@
 #define HKDF_HMAC_UPDATE ascon_hmac_update
 #define HKDF_HMAC_FINALIZE ascon_hmac_finalize
 #define HKDF_HMAC_FREE ascon_hmac_free
+#define HKDF_CONTEXT ascon_hkdf_context_t
+#define HKDF_HMAC_KEY_INIT ascon_hmac_key_init
+#define HKDF_HMAC_KEY_FREE ascon_hmac_key_free
+#define HKDF_HMAC_INIT_PRECOMPUTED ascon_hmac_init_precomputed
+#define HKDF_HMAC_FINALIZE_PRECOMPUTED ascon_hmac_finalize_precomputed
+#define HKDF_XOF_2WAY ascon_xof_absorb_squeeze_2way
 #include "kdf/ascon-hkdf-common.h"
@@ -37,4 +37,9 @@
 #define HKDF_HMAC_UPDATE ascon_hmaca_update
 #define HKDF_HMAC_FINALIZE ascon_hmaca_finalize
 #define HKDF_HMAC_FREE ascon_hmaca_free
+#define HKDF_CONTEXT ascon_hkdfa_context_t
+#define HKDF_HMAC_KEY_INIT ascon_hmaca_key_init
+#define HKDF_HMAC_KEY_FREE ascon_hmaca_key_free
+#define HKDF_HMAC_INIT_PRECOMPUTED ascon_hmaca_init_precomputed
+#define HKDF_HMAC_FINALIZE_PRECOMPUTED ascon_hmaca_finalize_precomputed
 #include "kdf/ascon-hkdf-common.h"
@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) 2023 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <ascon/kdf-tree.h>
+#include <ascon/utility.h>
+#include <string.h>
+
+/* Returns an all-ones mask if a == b, or zero otherwise, without branching */
+static uint64_t ascon_kdf_tree_eq(uint64_t a, uint64_t b)
+{
+    uint64_t x = a ^ b;
+    return ((x | (0 - x)) >> 63) - 1;
+}
+
+/* Returns an all-ones mask if a < b, or zero otherwise, without branching.
+ * Both values must be less than 2^63. */
+static uint64_t ascon_kdf_tree_lt(uint64_t a, uint64_t b)
+{
+    return 0 - ((a - b) >> 63);
+}
+
+/**
+ * \brief Encodes a path for a key derivation tree.
+ *
+ * \param path Returns the encoded path, zero-padded to
+ * ASCON_KDF_TREE_MAX_PATH bytes.
+ * \param ends Returns the offset of the end of each level in \a path.
+ * \param labels Points to the labels.
+ * \param labellens Points to the label lengths.
+ * \param depth Number of levels in the path.
+ *
+ * \return The length of the encoded path, or 0 if the path is too long.
+ *
+ * Each label is prefixed with its length, so a valid encoding is never
+ * a prefix of another at anything other than a level boundary.
+ */
+static size_t ascon_kdf_tree_encode
+    (unsigned char path[ASCON_KDF_TREE_MAX_PATH], size_t *ends,
+     const unsigned char *const *labels, const size_t *labellens,
+     size_t depth)
+{
+    size_t posn = 0;
+    size_t level;
+    memset(path, 0, ASCON_KDF_TREE_MAX_PATH);
+    for (level = 0; level < depth; ++level) {
+        size_t len = labellens[level];
+        if (len > 255 || len >= (ASCON_KDF_TREE_MAX_PATH - posn))
+            return 0;
+        path[posn++] = (unsigned char)len;
+        memcpy(path + posn, labels[level], len);
+        posn += len;
+        ends[level] = posn;
+    }
+    return posn;
+}
+
+/**
+ * \brief Looks up the deepest cached prefix of a path.
+ *
+ * \param tree The key derivation tree.
+ * \param key Returns the cached key for the prefix.  Left unchanged
+ * if there is no cached prefix.
+ * \param path The encoded path, zero-padded.
+ * \param pathlen Length of the encoded path.
+ *
+ * \return The length of the encoded prefix, or 0 if there is no prefix
+ * of the path in the cache.
+ *
+ * Every entry is examined in full and the result is selected with masks
+ * so that the memory access pattern does not depend upon which entry hit.
+ */
+static size_t ascon_kdf_tree_lookup
+    (ascon_kdf_tree_t *tree, unsigned char *key,
+     const unsigned char *path, size_t pathlen)
+{
+    ascon_kdf_tree_entry_t *entry;
+    uint64_t best = 0;
+    uint64_t winner = 0;
+    uint64_t match;
+    uint64_t take;
+    unsigned char diff;
+    unsigned char mask;
+    size_t index, posn;
+
+    /* Find the entry with the longest encoded path that is a prefix */
+    for (index = 0; index < tree->num_entries; ++index) {
+        entry = &(tree->entries[index]);
+        diff = 0;
+        for (posn = 0; posn < ASCON_KDF_TREE_MAX_PATH; ++posn) {
+            mask = (unsigned char)ascon_kdf_tree_lt(posn, entry->pathlen);
+            diff |= (entry->path[posn] ^ path[posn]) & mask;
+        }
+        match = ascon_kdf_tree_eq(diff, 0) &
+                ~ascon_kdf_tree_eq(entry->pathlen, 0) &
+                ~ascon_kdf_tree_lt(pathlen, entry->pathlen);
+        take = match & ascon_kdf_tree_lt(best, entry->pathlen);
+        best = (best & ~take) | (entry->pathlen & take);
+        winner = (winner & ~take) | ((uint64_t)index & take);
+        mask = (unsigned char)take;
+        for (posn = 0; posn < ASCON_KDF_TREE_KEY_SIZE; ++posn) {
+            key[posn] = (key[posn] & ~mask) | (entry->key[posn] & mask);
+        }
+    }
+
+    /* Mark the entry that we found as the most recently used.  Other
+     * entries may have the same path length, so select by index. */
+    if (tree->num_entries > 0) {
+        ++(tree->clock);
+        for (index = 0; index < tree->num_entries; ++index) {
+            entry = &(tree->entries[index]);
+            take = ascon_kdf_tree_eq(index, winner) &
+                   ~ascon_kdf_tree_eq(best, 0);
+            entry->last_used =
+                (entry->last_used & ~take) | (tree->clock & take);
+        }
+    }
+    return (size_t)best;
+}
+
+/**
+ * \brief Inserts a derived key into the cache, evicting the least
+ * recently used entry.
+ *
+ * \param tree The key derivation tree.
+ * \param key The derived key.
+ * \param path The encoded path, zero-padded.
+ * \param pathlen Length of the encoded path.
+ *
+ * Empty entries have a timestamp of zero so they are always used
+ * before any occupied entry is evicted.
+ *
+ * Every entry is rewritten with a masked select so that the memory
+ * access pattern does not depend upon which entry was evicted.  The
+ * whole of the victim is overwritten, including the unused tail of
+ * the path, so nothing from the evicted key is left behind.
+ */
+static void ascon_kdf_tree_insert
+    (ascon_kdf_tree_t *tree, const unsigned char *key,
+     const unsigned char *path, size_t pathlen)
+{
+    ascon_kdf_tree_entry_t *entry;
+    uint64_t victim = 0;
+    uint64_t oldest = tree->entries[0].last_used;
+    uint64_t take;
+    uint64_t clock;
+    unsigned char mask;
+    unsigned char byte;
+    size_t index, posn;
+
+    /* Scan the whole cache for the oldest entry */
+    for (index = 1; index < tree->num_entries; ++index) {
+        entry = &(tree->entries[index]);
+        take = ascon_kdf_tree_lt(entry->last_used, oldest);
+        victim = (victim & ~take) | (index & take);
+        oldest = (oldest & ~take) | (entry->last_used & take);
+    }
+
+    /* Replace the victim with the new key, touching every entry */
+    clock = ++(tree->clock);
+    for (index = 0; index < tree->num_entries; ++index) {
+        entry = &(tree->entries[index]);
+        take = ascon_kdf_tree_eq(index, victim);
+        mask = (unsigned char)take;
+        for (posn = 0; posn < ASCON_KDF_TREE_KEY_SIZE; ++posn) {
+            entry->key[posn] =
+                (entry->key[posn] & ~mask) | (key[posn] & mask);
+        }
+        for (posn = 0; posn < ASCON_KDF_TREE_MAX_PATH; ++posn) {
+            byte = path[posn] &
+                   (unsigned char)ascon_kdf_tree_lt(posn, pathlen);
+            entry->path[posn] = (entry->path[posn] & ~mask) | (byte & mask);
+        }
+        entry->pathlen = (size_t)
+            ((entry->pathlen & ~take) | ((uint64_t)pathlen & take));
+        entry->last_used = (entry->last_used & ~take) | (clock & take);
+    }
+}
+
+int ascon_kdf_tree_init
+    (ascon_kdf_tree_t *tree, const unsigned char *root, size_t rootlen,
+     ascon_kdf_tree_entry_t *entries, size_t num_entries)
+{
+    if (rootlen > ASCON_KDF_TREE_KEY_SIZE)
+        return -1;
+    memset(tree, 0, sizeof(ascon_kdf_tree_t));
+    memcpy(tree->root, root, rootlen);
+    tree->rootlen = rootlen;
+    tree->entries = entries;
+    tree->num_entries = num_entries;
+    if (num_entries > 0)
+        ascon_clean(entries, num_entries * sizeof(ascon_kdf_tree_entry_t));
+    return 0;
+}
+
+void ascon_kdf_tree_free(ascon_kdf_tree_t *tree)
+{
+    if (tree) {
+        if (tree->num_entries > 0) {
+            ascon_clean(tree->entries,
+                        tree->num_entries * sizeof(ascon_kdf_tree_entry_t));
+        }
+        ascon_clean(tree, sizeof(ascon_kdf_tree_t));
+    }
+}
+
+int ascon_kdf_tree_derive
+    (ascon_kdf_tree_t *tree, unsigned char *key,
+     const unsigned char *const *labels, const size_t *labellens,
+     size_t depth)
+{
+    unsigned char path[ASCON_KDF_TREE_MAX_PATH];
+    size_t ends[ASCON_KDF_TREE_MAX_PATH];
+    unsigned char parent[ASCON_KDF_TREE_KEY_SIZE];
+    size_t parentlen;
+    size_t pathlen;
+    size_t prefixlen;
+    size_t level;
+
+    /* Encode the path and validate the labels */
+    if (depth == 0 || depth > ASCON_KDF_TREE_MAX_PATH)
+        return -1;
+    pathlen = ascon_kdf_tree_encode(path, ends, labels, labellens, depth);
+    if (!pathlen)
+        return -1;
+
+    /* Start from the deepest cached prefix, or the root if none */
+    memcpy(parent, tree->root, tree->rootlen);
+    parentlen = tree->rootlen;
+    prefixlen = ascon_kdf_tree_lookup(tree, parent, path, pathlen);
+    level = 0;
+    if (prefixlen != 0) {
+        parentlen = ASCON_KDF_TREE_KEY_SIZE;
+        while (ends[level] != prefixlen)
+            ++level;
+        ++level;
+    }
+
+    /* Derive the remaining levels and add them to the cache */
+    for (; level < depth; ++level) {
+        ascon_kdf(key, ASCON_KDF_TREE_KEY_SIZE, parent, parentlen,
+                  labels[level], labellens[level]);
+        if (tree->num_entries > 0)
+            ascon_kdf_tree_insert(tree, key, path, ends[level]);
+        memcpy(parent, key, ASCON_KDF_TREE_KEY_SIZE);
+        parentlen = ASCON_KDF_TREE_KEY_SIZE;
+    }
+    memcpy(key, parent, ASCON_KDF_TREE_KEY_SIZE);
+    ascon_clean(parent, sizeof(parent));
+    return 0;
+}
+
+void ascon_kdf_tree_forget
+    (ascon_kdf_tree_t *tree, const unsigned char *const *labels,
+     const size_t *labellens, size_t depth)
+{
+    unsigned char path[ASCON_KDF_TREE_MAX_PATH];
+    size_t ends[ASCON_KDF_TREE_MAX_PATH];
+    ascon_kdf_tree_entry_t *entry;
+    size_t pathlen = 0;
+    size_t index;
+
+    /* If the path is invalid then it cannot be in the cache */
+    if (depth > 0) {
+        if (depth > ASCON_KDF_TREE_MAX_PATH)
+            return;
+        pathlen = ascon_kdf_tree_encode(path, ends, labels, labellens, depth);
+        if (!pathlen)
+            return;
+    }
+
+    /* Wipe every entry that starts with the path */
+    for (index = 0; index < tree->num_entries; ++index) {
+        entry = &(tree->entries[index]);
+        if (entry->pathlen != 0 && entry->pathlen >= pathlen &&
+                memcmp(entry->path, path, pathlen) == 0) {
+            ascon_clean(entry, sizeof(ascon_kdf_tree_entry_t));
+        }
+    }
+}
@@ -30,11 +30,14 @@
  * HMAC_HASH_SIZE       Size of the hash output for the underlying algorithm.
  * HMAC_BLOCK_SIZE      Size of the formatted key block for HMAC.
  * HMAC_STATE           Type for the HMAC state; e.g. ascon_hmac_state_t
+ * HMAC_KEY             Type for the pre-computed key; e.g. ascon_hmac_key_t
+ *                      (optional; omits the pre-computed key API if absent)
  * HMAC_HASH_INIT       Name of the hash initialization function.
  * HMAC_HASH_REINIT     Name of the hash re-initialization function.
  * HMAC_HASH_FREE       Name of the hash state free function.
  * HMAC_HASH_UPDATE     Name of the hash update function.
  * HMAC_HASH_FINALIZE   Name of the hash finalization function.
+ * HMAC_HASH_COPY       Name of the hash state copy function (if HMAC_KEY).
  */
 #if defined(HMAC_ALG_NAME)
 
@@ -172,6 +175,97 @@ void HMAC_CONCAT(HMAC_ALG_NAME,_finalize)
     ascon_clean(temp, sizeof(temp));
 }
 
+#if defined(HMAC_KEY)
+
+void HMAC_CONCAT(HMAC_ALG_NAME,_key_init)
+    (HMAC_KEY *key, const unsigned char *k, size_t keylen)
+{
+    HMAC_HASH_INIT(&(key->inner.hash));
+    HMAC_CONCAT(HMAC_ALG_NAME,_absorb_key)
+        (&(key->inner), k, keylen, HMAC_IPAD);
+    HMAC_HASH_INIT(&(key->outer.hash));
+    HMAC_CONCAT(HMAC_ALG_NAME,_absorb_key)
+        (&(key->outer), k, keylen, HMAC_OPAD);
+}
+
+void HMAC_CONCAT(HMAC_ALG_NAME,_key_free)(HMAC_KEY *key)
+{
+    if (key) {
+        HMAC_HASH_FREE(&(key->inner.hash));
+        HMAC_HASH_FREE(&(key->outer.hash));
+    }
+}
+
+void HMAC_CONCAT(HMAC_ALG_NAME,_with_key)
+    (unsigned char *out, const HMAC_KEY *key,
+     const unsigned char *in, size_t inlen)
+{
+    HMAC_STATE state;
+    HMAC_HASH_COPY(&(state.hash), &(key->inner.hash));
+    HMAC_HASH_UPDATE(&(state.hash), in, inlen);
+    HMAC_CONCAT(HMAC_ALG_NAME,_finalize_precomputed)(&state, key, out);
+    HMAC_HASH_FREE(&(state.hash));
+}
+
+void HMAC_CONCAT(HMAC_ALG_NAME,_init_precomputed)
+    (HMAC_STATE *state, const HMAC_KEY *key)
+{
+    HMAC_HASH_COPY(&(state->hash), &(key->inner.hash));
+}
+
+void HMAC_CONCAT(HMAC_ALG_NAME,_reinit_precomputed)
+    (HMAC_STATE *state, const HMAC_KEY *key)
+{
+    HMAC_HASH_FREE(&(state->hash));
+    HMAC_HASH_COPY(&(state->hash), &(key->inner.hash));
+}
+
+void HMAC_CONCAT(HMAC_ALG_NAME,_finalize_precomputed)
+    (HMAC_STATE *state, const HMAC_KEY *key, unsigned char *out)
+{
+    unsigned char temp[HMAC_HASH_SIZE];
+    HMAC_HASH_FINALIZE(&(state->hash), temp);
+    HMAC_HASH_FREE(&(state->hash));
+    HMAC_HASH_COPY(&(state->hash), &(key->outer.hash));
+    HMAC_HASH_UPDATE(&(state->hash), temp, HMAC_HASH_SIZE);
+    HMAC_HASH_FINALIZE(&(state->hash), out);
+    ascon_clean(temp, sizeof(temp));
+}
+
+int HMAC_CONCAT(HMAC_ALG_NAME,_verify_batch)
+    (unsigned char *results, const unsigned char *const *tag,
+     const unsigned char *const *in, const size_t *inlen,
+     const unsigned char *const *key, const size_t *keylen, size_t count)
+{
+    HMAC_KEY ctx;
+    unsigned char temp[HMAC_HASH_SIZE];
+    size_t index;
+    int result = 0;
+    int ok;
+    memset(results, 0, (count + 7) / 8);
+    for (index = 0; index < count; ++index) {
+        /* Consecutive items with the same key share the key context */
+        if (index == 0 || key[index] != key[index - 1] ||
+                keylen[index] != keylen[index - 1]) {
+            if (index > 0)
+                HMAC_CONCAT(HMAC_ALG_NAME,_key_free)(&ctx);
+            HMAC_CONCAT(HMAC_ALG_NAME,_key_init)
+                (&ctx, key[index], keylen[index]);
+        }
+        HMAC_CONCAT(HMAC_ALG_NAME,_with_key)
+            (temp, &ctx, in[index], inlen[index]);
+        ok = ascon_aead_check_tag(0, 0, tag[index], temp, HMAC_HASH_SIZE);
+        results[index / 8] |= (unsigned char)((ok + 1) << (index % 8));
+        result |= ok;
+    }
+    if (count > 0)
+        HMAC_CONCAT(HMAC_ALG_NAME,_key_free)(&ctx);
+    ascon_clean(temp, sizeof(temp));
+    return result;
+}
+
+#endif /* HMAC_KEY */
+
 #endif /* HMAC_ALG_NAME */
 
 /* Now undefine everything so that we can include this file again for
@@ -180,10 +274,13 @@ void HMAC_CONCAT(HMAC_ALG_NAME,_finalize)
 #undef HMAC_HASH_SIZE
 #undef HMAC_BLOCK_SIZE
 #undef HMAC_STATE
+#undef HMAC_KEY
 #undef HMAC_HASH_INIT
 #undef HMAC_HASH_REINIT
 #undef HMAC_HASH_UPDATE
+#undef HMAC_HASH_FREE
 #undef HMAC_HASH_FINALIZE
+#undef HMAC_HASH_COPY
 #undef HMAC_CONCAT_INNER
 #undef HMAC_CONCAT
 #undef HMAC_IPAD
@@ -22,6 +22,7 @@
 
 #include <ascon/hmac.h>
 #include <ascon/utility.h>
+#include "aead/ascon-aead-common.h"
 #include <string.h>
 
 /* The actual implementation is in the "ascon-hmac-common.h" file */
@@ -31,9 +32,11 @@
 #define HMAC_HASH_SIZE ASCON_HASHA_SIZE
 #define HMAC_BLOCK_SIZE 64
 #define HMAC_STATE ascon_hmaca_state_t
+#define HMAC_KEY ascon_hmaca_key_t
 #define HMAC_HASH_INIT ascon_hasha_init
 #define HMAC_HASH_REINIT ascon_hasha_reinit
 #define HMAC_HASH_FREE ascon_hasha_free
 #define HMAC_HASH_UPDATE ascon_hasha_update
 #define HMAC_HASH_FINALIZE ascon_hasha_finalize
+#define HMAC_HASH_COPY ascon_hasha_copy
 #include "mac/ascon-hmac-common.h"
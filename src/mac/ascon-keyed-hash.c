@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <ascon/keyed-hash.h>
+#include <ascon/utility.h>
+#include "core/ascon-util-snp.h"
+
+void ascon_keyed_hash_key_init
+    (ascon_keyed_hash_key_t *key, const unsigned char *k)
+{
+    memcpy(key->k, k, ASCON_KEYED_HASH_KEY_SIZE);
+}
+
+void ascon_keyed_hash_key_free(ascon_keyed_hash_key_t *key)
+{
+    if (key)
+        ascon_clean(key, sizeof(ascon_keyed_hash_key_t));
+}
+
+/**
+ * \brief Computes ASCON-PrfShort with an 8 byte output directly on the
+ * permutation state.
+ *
+ * \param key Points to the key.
+ * \param in Points to the input, which must be 16 bytes or less in size.
+ * \param inlen Length of the input in bytes.
+ *
+ * \return The first 8 bytes of the output as a big-endian word.
+ *
+ * The state starts out as zero so the IV, key, and input can be XOR'ed
+ * in with the backend's absorb primitives rather than being overwritten
+ * with ascon_overwrite_bytes() one byte at a time.  The 8 and 16 byte
+ * cases are the common ones for hash tables so they are unrolled.
+ */
+static uint64_t ascon_keyed_hash64_short
+    (const unsigned char *key, const unsigned char *in, unsigned inlen)
+{
+    ascon_state_t state;
+    unsigned char iv[8] = {0x80, 0x00, 0x4c, 0x80, 0x00, 0x00, 0x00, 0x00};
+    unsigned char out[8];
+    iv[1] = (unsigned char)(inlen * 8U);
+    ascon_init(&state);
+    ascon_absorb_8(&state, iv, 0);
+    ascon_absorb_16(&state, key, 8);
+    if (inlen == 16)
+        ascon_absorb_16(&state, in, 24);
+    else if (inlen == 8)
+        ascon_absorb_8(&state, in, 24);
+    else if (inlen > 0)
+        ascon_absorb_partial(&state, in, 24, inlen);
+    ascon_permute(&state, 0);
+    ascon_absorb_8(&state, key, 24);
+    ascon_squeeze_8(&state, out, 24);
+    ascon_free(&state);
+    return be_load_word64(out);
+}
+
+uint64_t ascon_keyed_hash64
+    (const ascon_keyed_hash_key_t *key, const unsigned char *in, size_t inlen)
+{
+    unsigned char out[8];
+    if (inlen <= ASCON_PRF_SHORT_MAX_INPUT_SIZE)
+        return ascon_keyed_hash64_short(key->k, in, (unsigned)inlen);
+    ascon_prf_fixed(out, sizeof(out), in, inlen, key->k);
+    return be_load_word64(out);
+}
+
+uint64_t ascon_keyed_hash64_u64
+    (const ascon_keyed_hash_key_t *key, uint64_t value)
+{
+    unsigned char in[8];
+    be_store_word64(in, value);
+    return ascon_keyed_hash64_short(key->k, in, 8);
+}
+
+uint64_t ascon_keyed_hash64_u128
+    (const ascon_keyed_hash_key_t *key, uint64_t high, uint64_t low)
+{
+    unsigned char in[16];
+    be_store_word64(in, high);
+    be_store_word64(in + 8, low);
+    return ascon_keyed_hash64_short(key->k, in, 16);
+}
@@ -31,7 +31,7 @@
  *
  * \param state Points to the internal ASCON-XOFA state to initialize.
  */
-static void ascon_kmaca_init_precomputed(ascon_xofa_state_t *state)
+static void ascon_kmaca_init_iv(ascon_xofa_state_t *state)
 {
 #if defined(ASCON_BACKEND_SLICED64)
     static uint64_t const iv[5] = {
@@ -80,16 +80,32 @@ void ascon_kmaca
     ascon_kmaca_free(&state);
 }
 
-void ascon_kmaca_init
-    (ascon_kmaca_state_t *state, const unsigned char *key, size_t keylen,
-     const unsigned char *custom, size_t customlen, size_t outlen)
+/**
+ * \brief Initializes an XOF state with the "KMAC" function name and
+ * a customization string, but without the key.
+ *
+ * \param state Points to the internal XOF state to initialize.
+ * \param custom Points to the customization string.
+ * \param customlen Number of bytes in the customization string.
+ * \param outlen The desired output length in bytes, or 0 for arbitrary-length.
+ */
+static void ascon_kmaca_init_custom
+    (ascon_xofa_state_t *state, const unsigned char *custom,
+     size_t customlen, size_t outlen)
 {
     if (outlen == ASCON_KMACA_SIZE) {
-        ascon_kmaca_init_precomputed(&(state->xof));
-        ascon_xofa_absorb_custom(&(state->xof), custom, customlen);
+        ascon_kmaca_init_iv(state);
+        ascon_xofa_absorb_custom(state, custom, customlen);
     } else {
-        ascon_xofa_init_custom(&(state->xof), "KMAC", custom, customlen, outlen);
+        ascon_xofa_init_custom(state, "KMAC", custom, customlen, outlen);
     }
+}
+
+void ascon_kmaca_init
+    (ascon_kmaca_state_t *state, const unsigned char *key, size_t keylen,
+     const unsigned char *custom, size_t customlen, size_t outlen)
+{
+    ascon_kmaca_init_custom(&(state->xof), custom, customlen, outlen);
     ascon_xofa_absorb(&(state->xof), key, keylen);
 }
 
@@ -118,3 +134,64 @@ void ascon_kmaca_squeeze
 {
     ascon_xofa_squeeze(&(state->xof), out, outlen);
 }
+
+void ascon_kmaca_precompute
+    (ascon_xofa_precomputed_t *pre, const unsigned char *custom,
+     size_t customlen, size_t outlen)
+{
+    ascon_kmaca_init_custom(&(pre->xof), custom, customlen, outlen);
+}
+
+void ascon_kmaca_init_precomputed
+    (ascon_kmaca_state_t *state, const ascon_xofa_precomputed_t *pre,
+     const unsigned char *key, size_t keylen)
+{
+    ascon_xofa_init_precomputed(&(state->xof), pre);
+    ascon_xofa_absorb(&(state->xof), key, keylen);
+}
+
+void ascon_kmaca_reinit_precomputed
+    (ascon_kmaca_state_t *state, const ascon_xofa_precomputed_t *pre,
+     const unsigned char *key, size_t keylen)
+{
+    ascon_kmaca_free(state);
+    ascon_kmaca_init_precomputed(state, pre, key, keylen);
+}
+
+void ascon_kmaca_key_init
+    (ascon_kmaca_key_t *key, const unsigned char *k, size_t keylen,
+     const unsigned char *custom, size_t customlen, size_t outlen)
+{
+    ascon_kmaca_init_custom(&(key->xof), custom, customlen, outlen);
+    ascon_xofa_absorb(&(key->xof), k, keylen);
+}
+
+void ascon_kmaca_key_free(ascon_kmaca_key_t *key)
+{
+    if (key)
+        ascon_xofa_free(&(key->xof));
+}
+
+void ascon_kmaca_init_keyed
+    (ascon_kmaca_state_t *state, const ascon_kmaca_key_t *key)
+{
+    ascon_xofa_copy(&(state->xof), &(key->xof));
+}
+
+void ascon_kmaca_reinit_keyed
+    (ascon_kmaca_state_t *state, const ascon_kmaca_key_t *key)
+{
+    ascon_kmaca_free(state);
+    ascon_xofa_copy(&(state->xof), &(key->xof));
+}
+
+void ascon_kmaca_with_key
+    (const ascon_kmaca_key_t *key, const unsigned char *in, size_t inlen,
+     unsigned char *out, size_t outlen)
+{
+    ascon_kmaca_state_t state;
+    ascon_xofa_copy(&(state.xof), &(key->xof));
+    ascon_xofa_absorb(&(state.xof), in, inlen);
+    ascon_xofa_squeeze(&(state.xof), out, outlen);
+    ascon_kmaca_free(&state);
+}
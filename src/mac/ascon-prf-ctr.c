@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <ascon/prf-ctr.h>
+#include <ascon/utility.h>
+#include "core/ascon-util-snp.h"
+#include "core/ascon-permute-2way.h"
+#include <string.h>
+
+/**
+ * \brief Number of keystream blocks to generate at once when processing
+ * whole blocks of data.
+ */
+#define ASCON_PRF_CTR_BATCH 4
+
+/**
+ * \brief Starts the ASCON-Prf computation for a keystream block by
+ * absorbing the nonce and block index from the key context.
+ *
+ * \param state The permutation state to set up, which must be acquired.
+ * \param ctr The ASCON-Prf counter mode state.
+ * \param block Index of the block.
+ */
+static void ascon_prf_ctr_start
+    (ascon_state_t *state, const ascon_prf_ctr_state_t *ctr, uint64_t block)
+{
+    unsigned char counter[8];
+    be_store_word64(counter, block);
+    ascon_copy(state, &(ctr->key.prf.state));
+    ascon_absorb_16(state, ctr->nonce, 0);
+    ascon_absorb_8(state, counter, 16);
+    ascon_pad(state, ASCON_PRF_CTR_NONCE_SIZE + 8);
+    ascon_separator(state);
+}
+
+void ascon_prf_ctr_blocks
+    (const ascon_prf_ctr_state_t *state, unsigned char *out,
+     uint64_t first_block, size_t num_blocks)
+{
+    ascon_state_t state1;
+    unsigned posn;
+#if defined(ASCON_PERMUTE_2WAY)
+    ascon_state_t state2;
+#endif
+    ascon_init(&state1);
+#if defined(ASCON_PERMUTE_2WAY)
+    /* Generate pairs of blocks with interleaved permutation calls */
+    ascon_init(&state2);
+    while (num_blocks >= 2) {
+        ascon_prf_ctr_start(&state1, state, first_block);
+        ascon_prf_ctr_start(&state2, state, first_block + 1);
+        for (posn = 0; posn < ASCON_PRF_CTR_BLOCK_SIZE; posn += 16) {
+            ascon_permute_2way(&state1, &state2, 0);
+            ascon_squeeze_16(&state1, out + posn, 0);
+            ascon_squeeze_16
+                (&state2, out + ASCON_PRF_CTR_BLOCK_SIZE + posn, 0);
+        }
+        out += ASCON_PRF_CTR_BLOCK_SIZE * 2;
+        first_block += 2;
+        num_blocks -= 2;
+    }
+    ascon_free(&state2);
+#endif
+    while (num_blocks > 0) {
+        ascon_prf_ctr_start(&state1, state, first_block);
+        for (posn = 0; posn < ASCON_PRF_CTR_BLOCK_SIZE; posn += 16) {
+            ascon_permute(&state1, 0);
+            ascon_squeeze_16(&state1, out + posn, 0);
+        }
+        out += ASCON_PRF_CTR_BLOCK_SIZE;
+        ++first_block;
+        --num_blocks;
+    }
+    ascon_free(&state1);
+}
+
+void ascon_prf_ctr_init
+    (ascon_prf_ctr_state_t *state, const unsigned char *key,
+     const unsigned char *nonce)
+{
+    ascon_prf_key_init(&(state->key), key, ASCON_PRF_CTR_BLOCK_SIZE);
+    memcpy(state->nonce, nonce, ASCON_PRF_CTR_NONCE_SIZE);
+    state->offset = 0;
+    state->block = 0;
+    state->buffered = 0;
+}
+
+void ascon_prf_ctr_free(ascon_prf_ctr_state_t *state)
+{
+    if (state) {
+        ascon_prf_key_free(&(state->key));
+        ascon_clean(state->nonce, sizeof(state->nonce));
+        ascon_clean(state->buffer, sizeof(state->buffer));
+        state->offset = 0;
+        state->block = 0;
+        state->buffered = 0;
+    }
+}
+
+void ascon_prf_ctr_seek(ascon_prf_ctr_state_t *state, uint64_t offset)
+{
+    state->offset = offset;
+}
+
+uint64_t ascon_prf_ctr_tell(const ascon_prf_ctr_state_t *state)
+{
+    return state->offset;
+}
+
+void ascon_prf_ctr_xor_at
+    (const ascon_prf_ctr_state_t *state, unsigned char *out,
+     const unsigned char *in, size_t len, uint64_t offset)
+{
+    unsigned char blocks[ASCON_PRF_CTR_BLOCK_SIZE * ASCON_PRF_CTR_BATCH];
+    uint64_t block = offset / ASCON_PRF_CTR_BLOCK_SIZE;
+    unsigned posn = (unsigned)(offset % ASCON_PRF_CTR_BLOCK_SIZE);
+    size_t num_blocks;
+    size_t temp;
+    while (len > 0) {
+        /* Generate enough blocks to cover as much of the data as we can */
+        num_blocks = (posn + len + ASCON_PRF_CTR_BLOCK_SIZE - 1) /
+                     ASCON_PRF_CTR_BLOCK_SIZE;
+        if (num_blocks > ASCON_PRF_CTR_BATCH)
+            num_blocks = ASCON_PRF_CTR_BATCH;
+        ascon_prf_ctr_blocks(state, blocks, block, num_blocks);
+
+        /* XOR the keystream with the data, skipping the leading bytes
+         * of the first block if the offset was not block-aligned */
+        temp = num_blocks * ASCON_PRF_CTR_BLOCK_SIZE - posn;
+        if (temp > len)
+            temp = len;
+        lw_xor_block_2_src(out, blocks + posn, in, (unsigned)temp);
+        out += temp;
+        in += temp;
+        len -= temp;
+        block += num_blocks;
+        posn = 0;
+    }
+    ascon_clean(blocks, sizeof(blocks));
+}
+
+/**
+ * \brief Encrypts or decrypts data within the block at the current
+ * position, using the buffered copy of the block if possible.
+ *
+ * \param state The ASCON-Prf counter mode state.
+ * \param out Points to the output buffer.
+ * \param in Points to the input buffer, or NULL to output the keystream.
+ * \param len Number of bytes to process, which must not cross the end
+ * of the current block.
+ */
+static void ascon_prf_ctr_partial
+    (ascon_prf_ctr_state_t *state, unsigned char *out,
+     const unsigned char *in, size_t len)
+{
+    uint64_t block = state->offset / ASCON_PRF_CTR_BLOCK_SIZE;
+    unsigned posn = (unsigned)(state->offset % ASCON_PRF_CTR_BLOCK_SIZE);
+    if (!state->buffered || state->block != block) {
+        ascon_prf_ctr_blocks(state, state->buffer, block, 1);
+        state->block = block;
+        state->buffered = 1;
+    }
+    if (in)
+        lw_xor_block_2_src(out, state->buffer + posn, in, (unsigned)len);
+    else
+        memcpy(out, state->buffer + posn, len);
+    state->offset += len;
+}
+
+void ascon_prf_ctr_keystream
+    (ascon_prf_ctr_state_t *state, unsigned char *out, size_t outlen)
+{
+    size_t temp;
+
+    /* Finish off the current block if we are part-way through it */
+    temp = (size_t)(state->offset % ASCON_PRF_CTR_BLOCK_SIZE);
+    if (temp != 0) {
+        temp = ASCON_PRF_CTR_BLOCK_SIZE - temp;
+        if (temp > outlen)
+            temp = outlen;
+        ascon_prf_ctr_partial(state, out, 0, temp);
+        out += temp;
+        outlen -= temp;
+    }
+
+    /* Generate whole blocks directly into the output buffer */
+    temp = outlen / ASCON_PRF_CTR_BLOCK_SIZE;
+    if (temp > 0) {
+        ascon_prf_ctr_blocks
+            (state, out, state->offset / ASCON_PRF_CTR_BLOCK_SIZE, temp);
+        temp *= ASCON_PRF_CTR_BLOCK_SIZE;
+        out += temp;
+        outlen -= temp;
+        state->offset += temp;
+    }
+
+    /* Buffer the last block if there is a partial block left over */
+    if (outlen > 0)
+        ascon_prf_ctr_partial(state, out, 0, outlen);
+}
+
+void ascon_prf_ctr_xor
+    (ascon_prf_ctr_state_t *state, unsigned char *out,
+     const unsigned char *in, size_t len)
+{
+    size_t temp;
+
+    /* Finish off the current block if we are part-way through it */
+    temp = (size_t)(state->offset % ASCON_PRF_CTR_BLOCK_SIZE);
+    if (temp != 0) {
+        temp = ASCON_PRF_CTR_BLOCK_SIZE - temp;
+        if (temp > len)
+            temp = len;
+        ascon_prf_ctr_partial(state, out, in, temp);
+        out += temp;
+        in += temp;
+        len -= temp;
+    }
+
+    /* Process whole blocks without going through the buffer */
+    temp = len - (len % ASCON_PRF_CTR_BLOCK_SIZE);
+    if (temp > 0) {
+        ascon_prf_ctr_xor_at(state, out, in, temp, state->offset);
+        out += temp;
+        in += temp;
+        len -= temp;
+        state->offset += temp;
+    }
+
+    /* Buffer the last block if there is a partial block left over */
+    if (len > 0)
+        ascon_prf_ctr_partial(state, out, in, len);
+}
@@ -24,6 +24,8 @@
 #include <ascon/utility.h>
 #include "core/ascon-util-snp.h"
 #include "aead/ascon-aead-common.h"
+#include "core/ascon-permute-2way.h"
+#include <string.h>
 
 /**
  * \brief Rate of absorption for input blocks.
@@ -112,8 +114,16 @@ void ascon_prf_init(ascon_prf_state_t *state, const unsigned char *key)
     ascon_prf_fixed_init(state, key, 0);
 }
 
-void ascon_prf_fixed_init
-    (ascon_prf_state_t *state, const unsigned char *key, size_t outlen)
+/**
+ * \brief Loads the IV and key into an ASCON-Prf state, ready for the
+ * first permutation call.
+ *
+ * \param state The ASCON-Prf state, which must be acquired.
+ * \param key Points to the ASCON_PRF_KEY_SIZE bytes of the key.
+ * \param outlen Number of bytes of output that is desired, or 0 for unlimited.
+ */
+static void ascon_prf_load_key
+    (ascon_state_t *state, const unsigned char *key, size_t outlen)
 {
     unsigned char iv[8] = {0x80, 0x80, 0x8c, 0x00, 0x00, 0x00, 0x00, 0x00};
 #if !defined(__SIZEOF_SIZE_T__) || __SIZEOF_SIZE_T__ >= 4
@@ -121,9 +131,15 @@ void ascon_prf_fixed_init
         outlen = 0; /* Too large, so switch to arbitrary-length output */
 #endif
     be_store_word32(iv + 4, (uint32_t)(outlen * 8U));
+    ascon_overwrite_bytes(state, iv, 0, 8);
+    ascon_overwrite_bytes(state, key, 8, ASCON_PRF_KEY_SIZE);
+}
+
+void ascon_prf_fixed_init
+    (ascon_prf_state_t *state, const unsigned char *key, size_t outlen)
+{
     ascon_init(&(state->state));
-    ascon_overwrite_bytes(&(state->state), iv, 0, 8);
-    ascon_overwrite_bytes(&(state->state), key, 8, ASCON_PRF_KEY_SIZE);
+    ascon_prf_load_key(&(state->state), key, outlen);
     ascon_permute(&(state->state), 0);
     ascon_release(&(state->state));
     state->count = 0;
@@ -255,3 +271,190 @@ void ascon_prf_squeeze
     /* Release access to the shared hardware */
     ascon_release(&(state->state));
 }
+
+void ascon_prf_key_init
+    (ascon_prf_key_t *key, const unsigned char *k, size_t outlen)
+{
+    ascon_prf_fixed_init(&(key->prf), k, outlen);
+}
+
+void ascon_prf_key_free(ascon_prf_key_t *key)
+{
+    if (key)
+        ascon_prf_free(&(key->prf));
+}
+
+void ascon_prf_init_keyed
+    (ascon_prf_state_t *state, const ascon_prf_key_t *key)
+{
+    ascon_init(&(state->state));
+    ascon_copy(&(state->state), &(key->prf.state));
+    ascon_release(&(state->state));
+    state->count = key->prf.count;
+    state->mode = key->prf.mode;
+}
+
+void ascon_prf_reinit_keyed
+    (ascon_prf_state_t *state, const ascon_prf_key_t *key)
+{
+    ascon_prf_free(state);
+    ascon_prf_init_keyed(state, key);
+}
+
+void ascon_prf_with_key
+    (unsigned char *out, size_t outlen,
+     const unsigned char *in, size_t inlen,
+     const ascon_prf_key_t *key)
+{
+    ascon_prf_state_t state;
+    ascon_prf_init_keyed(&state, key);
+    ascon_prf_absorb(&state, in, inlen);
+    ascon_prf_squeeze(&state, out, outlen);
+    ascon_prf_free(&state);
+}
+
+void ascon_mac_with_key
+    (unsigned char *tag,
+     const unsigned char *in, size_t inlen,
+     const ascon_prf_key_t *key)
+{
+    ascon_prf_with_key(tag, ASCON_MAC_TAG_SIZE, in, inlen, key);
+}
+
+int ascon_mac_verify_with_key
+    (const unsigned char *tag,
+     const unsigned char *in, size_t inlen,
+     const ascon_prf_key_t *key)
+{
+    unsigned char tag2[ASCON_MAC_TAG_SIZE];
+    int result;
+    ascon_mac_with_key(tag2, in, inlen, key);
+    result = ascon_aead_check_tag(0, 0, tag, tag2, sizeof(tag2));
+    ascon_clean(tag2, sizeof(tag2));
+    return result;
+}
+
+#if defined(ASCON_PERMUTE_2WAY)
+
+/**
+ * \brief Absorbs the full input blocks of a message that is longer than
+ * the message in the other lane.
+ *
+ * \param state The ASCON-Prf state.
+ * \param in Points to the input data.
+ * \param inlen Points to the length of the input data, which is updated
+ * to the length of the final partial block on exit.
+ *
+ * \return Pointer to the final partial block.
+ */
+static const unsigned char *ascon_mac_absorb_tail
+    (ascon_state_t *state, const unsigned char *in, size_t *inlen)
+{
+    while (*inlen >= ASCON_PRF_RATE_IN) {
+        ascon_absorb_16(state, in, 0);
+        ascon_absorb_16(state, in + 16, 16);
+        ascon_permute(state, 0);
+        in += ASCON_PRF_RATE_IN;
+        *inlen -= ASCON_PRF_RATE_IN;
+    }
+    return in;
+}
+
+/**
+ * \brief Computes two ASCON-Mac tags side by side.
+ *
+ * The permutation calls for the key setup, the input blocks that both
+ * messages have in common, and the final output block are interleaved.
+ * The result is the same as calling ascon_mac() twice.
+ */
+static void ascon_mac_2way
+    (unsigned char *tag1, const unsigned char *in1, size_t inlen1,
+     const unsigned char *key1,
+     unsigned char *tag2, const unsigned char *in2, size_t inlen2,
+     const unsigned char *key2)
+{
+    ascon_state_t state1;
+    ascon_state_t state2;
+
+    /* Load the keys and run the initial permutation */
+    ascon_init(&state1);
+    ascon_init(&state2);
+    ascon_prf_load_key(&state1, key1, ASCON_MAC_TAG_SIZE);
+    ascon_prf_load_key(&state2, key2, ASCON_MAC_TAG_SIZE);
+    ascon_permute_2way(&state1, &state2, 0);
+
+    /* Absorb the input blocks that both messages have */
+    while (inlen1 >= ASCON_PRF_RATE_IN && inlen2 >= ASCON_PRF_RATE_IN) {
+        ascon_absorb_16(&state1, in1, 0);
+        ascon_absorb_16(&state1, in1 + 16, 16);
+        ascon_absorb_16(&state2, in2, 0);
+        ascon_absorb_16(&state2, in2 + 16, 16);
+        ascon_permute_2way(&state1, &state2, 0);
+        in1 += ASCON_PRF_RATE_IN;
+        in2 += ASCON_PRF_RATE_IN;
+        inlen1 -= ASCON_PRF_RATE_IN;
+        inlen2 -= ASCON_PRF_RATE_IN;
+    }
+
+    /* At most one of the messages has full blocks left */
+    in1 = ascon_mac_absorb_tail(&state1, in1, &inlen1);
+    in2 = ascon_mac_absorb_tail(&state2, in2, &inlen2);
+
+    /* Pad the final blocks and squeeze out the tags */
+    if (inlen1 > 0)
+        ascon_absorb_partial(&state1, in1, 0, (unsigned)inlen1);
+    if (inlen2 > 0)
+        ascon_absorb_partial(&state2, in2, 0, (unsigned)inlen2);
+    ascon_pad(&state1, (unsigned)inlen1);
+    ascon_pad(&state2, (unsigned)inlen2);
+    ascon_separator(&state1);
+    ascon_separator(&state2);
+    ascon_permute_2way(&state1, &state2, 0);
+    ascon_squeeze_16(&state1, tag1, 0);
+    ascon_squeeze_16(&state2, tag2, 0);
+    ascon_free(&state1);
+    ascon_free(&state2);
+}
+
+#endif /* ASCON_PERMUTE_2WAY */
+
+int ascon_mac_verify_batch
+    (unsigned char *results, const unsigned char *const *tag,
+     const unsigned char *const *in, const size_t *inlen,
+     const unsigned char *const *key, size_t count)
+{
+    unsigned char tags[ASCON_MAC_TAG_SIZE * 2];
+    size_t index = 0;
+    int result = 0;
+    int ok;
+    memset(results, 0, (count + 7) / 8);
+#if defined(ASCON_PERMUTE_2WAY)
+    /* Compute the tags in pairs, and then check the pair */
+    for (; (count - index) >= 2; index += 2) {
+        ascon_mac_2way
+            (tags, in[index], inlen[index], key[index],
+             tags + ASCON_MAC_TAG_SIZE, in[index + 1], inlen[index + 1],
+             key[index + 1]);
+        ok = ascon_aead_check_tag
+            (0, 0, tag[index], tags, ASCON_MAC_TAG_SIZE);
+        results[index / 8] |= (unsigned char)((ok + 1) << (index % 8));
+        result |= ok;
+        ok = ascon_aead_check_tag
+            (0, 0, tag[index + 1], tags + ASCON_MAC_TAG_SIZE,
+             ASCON_MAC_TAG_SIZE);
+        results[(index + 1) / 8] |=
+            (unsigned char)((ok + 1) << ((index + 1) % 8));
+        result |= ok;
+    }
+#endif
+    /* Check the remaining tags one at a time */
+    for (; index < count; ++index) {
+        ascon_mac(tags, in[index], inlen[index], key[index]);
+        ok = ascon_aead_check_tag
+            (0, 0, tag[index], tags, ASCON_MAC_TAG_SIZE);
+        results[index / 8] |= (unsigned char)((ok + 1) << (index % 8));
+        result |= ok;
+    }
+    ascon_clean(tags, sizeof(tags));
+    return result;
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <ascon/pbkdf2.h>
+#include <ascon/utility.h>
+#include "core/ascon-util.h"
+#include "core/ascon-timing.h"
+#include <string.h>
+
+/* Number of measurements to take, keeping the fastest */
+#define ASCON_PBKDF2_CALIBRATE_RUNS 3
+
+/* Largest iteration count that we will return */
+#define ASCON_PBKDF2_CALIBRATE_MAX 0xFFFFFFFFUL
+
+/**
+ * \brief Measures the time taken to derive a key with PBKDF2.
+ *
+ * \param variant The PBKDF2 variant to measure.
+ * \param count The iteration count to use.
+ *
+ * \return The number of timer ticks that were taken.
+ */
+static ascon_timer_t ascon_pbkdf2_measure(int variant, unsigned long count)
+{
+    static unsigned char const password[] = "calibrate";
+    static unsigned char const salt[] = "0123456789abcdef";
+    unsigned char out[ASCON_PBKDF2_SIZE];
+    ascon_timer_t start, end;
+    start = ascon_timer_get_time();
+    if (variant == ASCON_PBKDF2_CALIBRATE_HMAC) {
+        ascon_pbkdf2_hmac
+            (out, sizeof(out), password, sizeof(password) - 1,
+             salt, sizeof(salt) - 1, count);
+    } else {
+        ascon_pbkdf2
+            (out, sizeof(out), password, sizeof(password) - 1,
+             salt, sizeof(salt) - 1, count);
+    }
+    end = ascon_timer_get_time();
+    ascon_clean(out, sizeof(out));
+    return (end > start) ? (end - start) : 1;
+}
+
+unsigned long ascon_pbkdf2_calibrate(unsigned long target_ms, int variant)
+{
+    ascon_timer_t ticks, target, min_ticks, elapsed, best;
+    uint64_t trial, result;
+    int run;
+
+    /* Can we measure time on this platform? */
+    if (!ascon_timer_init())
+        return 0;
+    ticks = ascon_timer_ticks_per_second();
+    if (!ticks)
+        return 0;
+    if (!target_ms)
+        target_ms = 1;
+    target = (ticks / 1000U) * target_ms;
+
+    /* Double the trial iteration count until a single run takes long
+     * enough to be measured accurately: 1/8th of the target, but no
+     * less than 10 milliseconds */
+    min_ticks = target / 8U;
+    if (min_ticks < ticks / 100U)
+        min_ticks = ticks / 100U;
+    trial = 256;
+    for (;;) {
+        elapsed = ascon_pbkdf2_measure(variant, (unsigned long)trial);
+        if (elapsed >= min_ticks || trial >= ASCON_PBKDF2_CALIBRATE_MAX / 2U)
+            break;
+        trial *= 2U;
+    }
+
+    /* Repeat the measurement and keep the fastest time.  Slower runs
+     * were probably interrupted, and erring on the side of a higher
+     * iteration count is the safer choice for password hashing. */
+    best = elapsed;
+    for (run = 1; run < ASCON_PBKDF2_CALIBRATE_RUNS; ++run) {
+        elapsed = ascon_pbkdf2_measure(variant, (unsigned long)trial);
+        if (elapsed < best)
+            best = elapsed;
+    }
+
+    /* Scale the trial count to the target time */
+    if (target <= (UINT64_MAX / trial))
+        result = (trial * target) / best;
+    else
+        result = trial * (target / best);
+    if (result < 1)
+        result = 1;
+    else if (result > ASCON_PBKDF2_CALIBRATE_MAX)
+        result = ASCON_PBKDF2_CALIBRATE_MAX;
+    return (unsigned long)result;
+}
+
+/*
+ * Format of a saved calibration result:
+ *
+ * - Magic number "APBC" (4 bytes)
+ * - Variant (1 byte)
+ * - Reserved, set to zero (3 bytes)
+ * - Target time in milliseconds, big-endian (4 bytes)
+ * - Iteration count, big-endian (4 bytes)
+ */
+
+unsigned long ascon_pbkdf2_calibrate_stored
+    (unsigned long target_ms, int variant, const ascon_storage_t *storage)
+{
+    unsigned char record[ASCON_PBKDF2_CALIBRATION_SIZE];
+    unsigned char expected[8];
+    unsigned long count;
+
+    /* Validate the parameters */
+    if (!storage || storage->size < ASCON_PBKDF2_CALIBRATION_SIZE)
+        return ascon_pbkdf2_calibrate(target_ms, variant);
+
+    /* Use the previous result if it was for the same parameters */
+    memcpy(expected, "APBC", 4);
+    expected[4] = (unsigned char)variant;
+    expected[5] = 0;
+    expected[6] = 0;
+    expected[7] = 0;
+    if ((*(storage->read))(storage, 0, record, sizeof(record))
+            == ASCON_PBKDF2_CALIBRATION_SIZE &&
+            memcmp(record, expected, sizeof(expected)) == 0 &&
+            be_load_word32(record + 8) == (uint32_t)target_ms) {
+        count = be_load_word32(record + 12);
+        if (count != 0)
+            return count;
+    }
+
+    /* Measure the speed of the machine and save the result */
+    count = ascon_pbkdf2_calibrate(target_ms, variant);
+    if (count != 0) {
+        memcpy(record, expected, sizeof(expected));
+        be_store_word32(record + 8, (uint32_t)target_ms);
+        be_store_word32(record + 12, (uint32_t)count);
+        (*(storage->write))
+            (storage, 0, record, sizeof(record), (storage->erase_size != 0));
+    }
+    return count;
+}
@@ -24,30 +24,32 @@
 #include <ascon/hmac.h>
 #include <ascon/utility.h>
 #include "core/ascon-util.h"
+#include "hash/ascon-xof-internal.h"
 #include <string.h>
 
-/* Implementation of the "F" function from RFC 8018, section 5.2 */
+/* Implementation of the "F" function from RFC 8018, section 5.2.
+ * The padded password is absorbed into the inner and outer HMAC states
+ * once up front and then each iteration starts from copies of those. */
 static void ascon_pbkdf2_hmac_f
     (ascon_hmac_state_t *state, unsigned char *T, unsigned char *U,
-     const unsigned char *password, size_t passwordlen,
-     const unsigned char *salt, size_t saltlen,
+     const ascon_hmac_key_t *key, const unsigned char *salt, size_t saltlen,
      unsigned long count, unsigned long blocknum)
 {
     unsigned char b[4];
     be_store_word32(b, blocknum);
-    ascon_hmac_init(state, password, passwordlen);
+    ascon_hmac_init_precomputed(state, key);
     ascon_hmac_update(state, salt, saltlen);
     ascon_hmac_update(state, b, sizeof(b));
-    ascon_hmac_finalize(state, password, passwordlen, T);
+    ascon_hmac_finalize_precomputed(state, key, T);
     if (count > 1) {
-        ascon_hmac_reinit(state, password, passwordlen);
+        ascon_hmac_reinit_precomputed(state, key);
         ascon_hmac_update(state, T, ASCON_HMAC_SIZE);
-        ascon_hmac_finalize(state, password, passwordlen, U);
+        ascon_hmac_finalize_precomputed(state, key, U);
         lw_xor_block(T, U, ASCON_HMAC_SIZE);
         while (count > 2) {
-            ascon_hmac_reinit(state, password, passwordlen);
+            ascon_hmac_reinit_precomputed(state, key);
             ascon_hmac_update(state, U, ASCON_HMAC_SIZE);
-            ascon_hmac_finalize(state, password, passwordlen, U);
+            ascon_hmac_finalize_precomputed(state, key, U);
             lw_xor_block(T, U, ASCON_HMAC_SIZE);
             --count;
         }
@@ -55,29 +57,65 @@ static void ascon_pbkdf2_hmac_f
     ascon_hmac_free(state);
 }
 
+/*
+ * Computes two consecutive output blocks of PBKDF2-HMAC side by side.
+ * Each iteration runs the inner hash for both blocks together and then
+ * the outer hash for both blocks together, so that the permutation calls
+ * for the two independent blocks can be interleaved.
+ */
+static void ascon_pbkdf2_hmac_f_2way
+    (ascon_hmac_state_t *state, unsigned char *T, unsigned char *U,
+     const ascon_hmac_key_t *key, const unsigned char *salt, size_t saltlen,
+     unsigned long count, unsigned long blocknum)
+{
+    unsigned char *T2 = T + ASCON_HMAC_SIZE;
+    unsigned char *U2 = U + ASCON_HMAC_SIZE;
+    ascon_pbkdf2_hmac_f(state, T, U, key, salt, saltlen, 1, blocknum);
+    ascon_pbkdf2_hmac_f(state, T2, U2, key, salt, saltlen, 1, blocknum + 1);
+    memcpy(U, T, ASCON_HMAC_SIZE * 2);
+    while (count > 1) {
+        ascon_xof_absorb_squeeze_2way
+            (&(key->inner.hash.xof), U, U,
+             &(key->inner.hash.xof), U2, U2,
+             ASCON_HMAC_SIZE, ASCON_HMAC_SIZE);
+        ascon_xof_absorb_squeeze_2way
+            (&(key->outer.hash.xof), U, U,
+             &(key->outer.hash.xof), U2, U2,
+             ASCON_HMAC_SIZE, ASCON_HMAC_SIZE);
+        lw_xor_block(T, U, ASCON_HMAC_SIZE * 2);
+        --count;
+    }
+}
+
 void ascon_pbkdf2_hmac
     (unsigned char *out, size_t outlen,
      const unsigned char *password, size_t passwordlen,
      const unsigned char *salt, size_t saltlen, unsigned long count)
 {
+    ascon_hmac_key_t key;
     ascon_hmac_state_t state;
-    unsigned char U[ASCON_HMAC_SIZE];
+    unsigned char T[ASCON_HMAC_SIZE * 2];
+    unsigned char U[ASCON_HMAC_SIZE * 2];
     unsigned long blocknum = 1;
+    size_t len;
+    ascon_hmac_key_init(&key, password, passwordlen);
     while (outlen > 0) {
-        if (outlen >= ASCON_HMAC_SIZE) {
-            ascon_pbkdf2_hmac_f(&state, out, U, password, passwordlen,
-                                salt, saltlen, count, blocknum);
-            out += ASCON_HMAC_SIZE;
-            outlen -= ASCON_HMAC_SIZE;
+        if (outlen > ASCON_HMAC_SIZE) {
+            /* At least two blocks are left, so compute them together */
+            ascon_pbkdf2_hmac_f_2way
+                (&state, T, U, &key, salt, saltlen, count, blocknum);
+            len = (outlen < sizeof(T)) ? outlen : sizeof(T);
+            blocknum += 2;
         } else {
-            unsigned char T[ASCON_HMAC_SIZE];
-            ascon_pbkdf2_hmac_f(&state, T, U, password, passwordlen,
-                                salt, saltlen, count, blocknum);
-            memcpy(out, T, outlen);
-            ascon_clean(T, sizeof(T));
-            break;
+            ascon_pbkdf2_hmac_f
+                (&state, T, U, &key, salt, saltlen, count, blocknum);
+            len = outlen;
         }
-        ++blocknum;
+        memcpy(out, T, len);
+        out += len;
+        outlen -= len;
     }
+    ascon_hmac_key_free(&key);
+    ascon_clean(T, sizeof(T));
     ascon_clean(U, sizeof(U));
 }
@@ -25,6 +25,7 @@
 #include <ascon/utility.h>
 #include "core/ascon-util.h"
 #include "core/ascon-util-snp.h"
+#include "hash/ascon-xof-internal.h"
 #include <string.h>
 
 /* Determine if we need to explicitly free the XOF state between iterations */
@@ -79,30 +80,115 @@ static void ascon_pbkdf2_f
 #endif
 }
 
+/*
+ * Computes two independent output blocks of PBKDF2 side by side.
+ * The blocks may come from the same password or from different ones.
+ * The permutation calls for both blocks are interleaved to make better
+ * use of the CPU.  T and U must be 2 * ASCON_PBKDF2_SIZE bytes in size.
+ */
+static void ascon_pbkdf2_f_2way
+    (ascon_xof_state_t *state1, const unsigned char *salt1,
+     size_t saltlen1, unsigned long blocknum1,
+     ascon_xof_state_t *state2, const unsigned char *salt2,
+     size_t saltlen2, unsigned long blocknum2,
+     unsigned char *T, unsigned char *U, unsigned long count)
+{
+    unsigned char *T2 = T + ASCON_PBKDF2_SIZE;
+    unsigned char *U2 = U + ASCON_PBKDF2_SIZE;
+    ascon_pbkdf2_f(state1, T, U, salt1, saltlen1, 1, blocknum1);
+    ascon_pbkdf2_f(state2, T2, U2, salt2, saltlen2, 1, blocknum2);
+    memcpy(U, T, ASCON_PBKDF2_SIZE * 2);
+    while (count > 1) {
+        ascon_xof_absorb_squeeze_2way
+            (state1, U, U, state2, U2, U2,
+             ASCON_PBKDF2_SIZE, ASCON_PBKDF2_SIZE);
+        lw_xor_block(T, U, ASCON_PBKDF2_SIZE * 2);
+        --count;
+    }
+}
+
 void ascon_pbkdf2
     (unsigned char *out, size_t outlen,
      const unsigned char *password, size_t passwordlen,
      const unsigned char *salt, size_t saltlen, unsigned long count)
 {
     ascon_xof_state_t state;
-    unsigned char U[ASCON_PBKDF2_SIZE];
+    unsigned char T[ASCON_PBKDF2_SIZE * 2];
+    unsigned char U[ASCON_PBKDF2_SIZE * 2];
     unsigned long blocknum = 1;
+    size_t len;
     ascon_xof_init_custom
         (&state, "PBKDF2", password, passwordlen, ASCON_PBKDF2_SIZE);
     while (outlen > 0) {
-        if (outlen >= ASCON_PBKDF2_SIZE) {
-            ascon_pbkdf2_f(&state, out, U, salt, saltlen, count, blocknum);
-            out += ASCON_PBKDF2_SIZE;
-            outlen -= ASCON_PBKDF2_SIZE;
+        if (outlen > ASCON_PBKDF2_SIZE) {
+            /* At least two blocks are left, so compute them together */
+            ascon_pbkdf2_f_2way
+                (&state, salt, saltlen, blocknum,
+                 &state, salt, saltlen, blocknum + 1, T, U, count);
+            len = (outlen < sizeof(T)) ? outlen : sizeof(T);
+            blocknum += 2;
         } else {
-            unsigned char T[ASCON_PBKDF2_SIZE];
             ascon_pbkdf2_f(&state, T, U, salt, saltlen, count, blocknum);
-            memcpy(out, T, outlen);
-            ascon_clean(T, sizeof(T));
-            break;
+            len = outlen;
         }
-        ++blocknum;
+        memcpy(out, T, len);
+        out += len;
+        outlen -= len;
     }
     ascon_xof_free(&state);
+    ascon_clean(T, sizeof(T));
+    ascon_clean(U, sizeof(U));
+}
+
+void ascon_pbkdf2_batch
+    (unsigned char *const *out, size_t outlen,
+     const unsigned char *const *password, const size_t *passwordlen,
+     const unsigned char *const *salt, const size_t *saltlen,
+     size_t num, unsigned long count)
+{
+    ascon_xof_state_t state1;
+    ascon_xof_state_t state2;
+    unsigned char T[ASCON_PBKDF2_SIZE * 2];
+    unsigned char U[ASCON_PBKDF2_SIZE * 2];
+    unsigned long blocknum;
+    size_t posn, len;
+
+    /* Derive the keys for the passwords in pairs */
+    while (num >= 2) {
+        ascon_xof_init_custom
+            (&state1, "PBKDF2", password[0], passwordlen[0],
+             ASCON_PBKDF2_SIZE);
+        ascon_xof_init_custom
+            (&state2, "PBKDF2", password[1], passwordlen[1],
+             ASCON_PBKDF2_SIZE);
+        blocknum = 1;
+        for (posn = 0; posn < outlen; posn += len) {
+            ascon_pbkdf2_f_2way
+                (&state1, salt[0], saltlen[0], blocknum,
+                 &state2, salt[1], saltlen[1], blocknum, T, U, count);
+            len = outlen - posn;
+            if (len > ASCON_PBKDF2_SIZE)
+                len = ASCON_PBKDF2_SIZE;
+            memcpy(out[0] + posn, T, len);
+            memcpy(out[1] + posn, T + ASCON_PBKDF2_SIZE, len);
+            ++blocknum;
+        }
+        ascon_xof_free(&state1);
+        ascon_xof_free(&state2);
+        out += 2;
+        password += 2;
+        passwordlen += 2;
+        salt += 2;
+        saltlen += 2;
+        num -= 2;
+    }
+
+    /* Derive the key for the left-over password on its own */
+    if (num > 0) {
+        ascon_pbkdf2
+            (out[0], outlen, password[0], passwordlen[0],
+             salt[0], saltlen[0], count);
+    }
+    ascon_clean(T, sizeof(T));
     ascon_clean(U, sizeof(U));
 }
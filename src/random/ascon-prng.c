@@ -23,13 +23,22 @@
 #include <ascon/random.h>
 #include <ascon/utility.h>
 #include "random/ascon-trng.h"
+#include "random/ascon-random-stats.h"
 #include "core/ascon-util-snp.h"
+#include <string.h>
 
 /**
  * \brief Automatically re-seed after generating more than this many bytes.
  */
 #define ASCON_RANDOM_RESEED_LIMIT 16384
 
+/**
+ * \brief Flag that indicates that a pseudorandom number generator was
+ * seeded by the application and must not mix in the system random
+ * number source automatically.
+ */
+#define ASCON_RANDOM_FLAG_DETERMINISTIC 0x0001
+
 /**
  * \brief Re-keys the state of a pseudorandom number generator.
  *
@@ -52,6 +61,8 @@ static void ascon_random_rekey(ascon_random_state_t *state)
 {
     int temp;
 
+    ascon_random_stats_add(rekeys, 1);
+
     /* Zero out part of the state and run the permutation several times.
      * This enforces forward security on the SpongePRNG state. */
     ascon_xof_pad(&(state->xof));
@@ -71,7 +82,7 @@ int ascon_random_init(ascon_random_state_t *state)
         return 0;
     ascon_xof_init_custom(&(state->xof), "SpongePRNG", 0, 0, 0);
     state->counter = 0;
-    state->reserved = 0;
+    state->flags = 0;
     ok = ascon_trng_generate(seed, sizeof(seed));
     ascon_xof_absorb(&(state->xof), seed, sizeof(seed));
     ascon_clean(seed, sizeof(seed));
@@ -79,28 +90,52 @@ int ascon_random_init(ascon_random_state_t *state)
     return ok;
 }
 
+void ascon_random_init_deterministic
+    (ascon_random_state_t *state, const unsigned char *seed, size_t seedlen)
+{
+    if (state) {
+        /* Use a different customization string to the TRNG-seeded
+         * generator so that the two can never produce the same output */
+        ascon_xof_init_custom(&(state->xof), "SpongePRNG-DRBG", 0, 0, 0);
+        state->counter = 0;
+        state->flags = ASCON_RANDOM_FLAG_DETERMINISTIC;
+        ascon_xof_absorb(&(state->xof), seed, seedlen);
+        ascon_random_rekey(state);
+    }
+}
+
 void ascon_random_free(ascon_random_state_t *state)
 {
     if (state) {
         state->counter = 0;
+        state->flags = 0;
         ascon_xof_free(&(state->xof));
     }
 }
 
-void ascon_random_fetch
+/**
+ * \brief Squeezes data out of a pseudorandom number generator without
+ * re-keying it afterwards.
+ *
+ * \param state The pseudorandom number generator state to use.
+ * \param out Points to a buffer to receive the random data.
+ * \param outlen Number of bytes of random data to squeeze.
+ */
+static void ascon_random_squeeze
     (ascon_random_state_t *state, unsigned char *out, size_t outlen)
 {
-    /* If there is no state, use the global ascon_random() function
-     * so that we return something.  Safer than returning nothing
-     * to the caller by accident and having them use that nothing. */
-    if (!state) {
-        ascon_random(out, outlen);
+    /* Deterministic generators never mix in the system random number
+     * source because that would make the output unreproducible */
+    if (state->flags & ASCON_RANDOM_FLAG_DETERMINISTIC) {
+        ascon_xof_squeeze(&(state->xof), out, outlen);
         return;
     }
 
     /* Force a re-seed if we have generated too many bytes so far */
-    if (state->counter >= ASCON_RANDOM_RESEED_LIMIT)
+    if (state->counter >= ASCON_RANDOM_RESEED_LIMIT) {
+        ascon_random_stats_add(auto_reseeds, 1);
         ascon_random_reseed(state);
+    }
 
     /* Squeeze data out of the PRNG state */
     ascon_xof_squeeze(&(state->xof), out, outlen);
@@ -108,22 +143,48 @@ void ascon_random_fetch
         state->counter += outlen;
     else
         state->counter = ASCON_RANDOM_RESEED_LIMIT;
+}
+
+void ascon_random_fetch
+    (ascon_random_state_t *state, unsigned char *out, size_t outlen)
+{
+    /* If there is no state, use the global ascon_random() function
+     * so that we return something.  Safer than returning nothing
+     * to the caller by accident and having them use that nothing. */
+    if (!state) {
+        ascon_random(out, outlen);
+        return;
+    }
 
-    /* Re-key the PRNG to enforce forward security */
+    /* Squeeze the data and then re-key to enforce forward security */
+    ascon_random_squeeze(state, out, outlen);
     ascon_random_rekey(state);
 }
 
+void ascon_random_generate
+    (ascon_random_state_t *state, unsigned char *out, size_t outlen)
+{
+    if (!state) {
+        ascon_random(out, outlen);
+        return;
+    }
+    ascon_random_squeeze(state, out, outlen);
+}
+
 int ascon_random_reseed(ascon_random_state_t *state)
 {
     if (state) {
         /* Generate a new system seed and absorb it into the state */
         unsigned char seed[ASCON_SYSTEM_SEED_SIZE];
         int ok = ascon_trng_generate(seed, sizeof(seed));
+        ascon_random_stats_add(reseeds, 1);
         ascon_xof_absorb(&(state->xof), seed, sizeof(seed));
         ascon_clean(seed, sizeof(seed));
 
-        /* Reset the re-seed counter to 0 */
+        /* Reset the re-seed counter to 0.  The generator is no longer
+         * deterministic once the system seed has been mixed in. */
         state->counter = 0;
+        state->flags &= ~ASCON_RANDOM_FLAG_DETERMINISTIC;
 
         /* Re-key the PRNG to enforce forward security */
         ascon_random_rekey(state);
@@ -192,3 +253,95 @@ int ascon_random_load_seed
     ascon_clean(seed, sizeof(seed));
     return read == ASCON_RANDOM_SAVED_SEED_SIZE;
 }
+
+/**
+ * \brief Discards the unused output in a buffered pseudorandom
+ * number generator.
+ *
+ * \param pool The buffered pseudorandom number generator.
+ */
+static void ascon_random_pool_discard(ascon_random_pool_t *pool)
+{
+    ascon_clean(pool->pool, sizeof(pool->pool));
+    pool->posn = ASCON_RANDOM_POOL_SIZE;
+}
+
+int ascon_random_pool_init(ascon_random_pool_t *pool)
+{
+    if (!pool)
+        return 0;
+    ascon_random_pool_discard(pool);
+    return ascon_random_init(&(pool->prng));
+}
+
+void ascon_random_pool_init_deterministic
+    (ascon_random_pool_t *pool, const unsigned char *seed, size_t seedlen)
+{
+    if (pool) {
+        ascon_random_pool_discard(pool);
+        ascon_random_init_deterministic(&(pool->prng), seed, seedlen);
+    }
+}
+
+void ascon_random_pool_free(ascon_random_pool_t *pool)
+{
+    if (pool) {
+        ascon_random_free(&(pool->prng));
+        ascon_random_pool_discard(pool);
+    }
+}
+
+void ascon_random_pool_fetch
+    (ascon_random_pool_t *pool, unsigned char *out, size_t outlen)
+{
+    size_t temp;
+
+    /* If there is no pool, then fall back to the global generator */
+    if (!pool) {
+        ascon_random(out, outlen);
+        return;
+    }
+
+    while (outlen > 0) {
+        /* Large requests bypass the pool once it has been used up */
+        if (pool->posn >= ASCON_RANDOM_POOL_SIZE &&
+                outlen >= ASCON_RANDOM_POOL_SIZE) {
+            ascon_random_fetch(&(pool->prng), out, outlen);
+            break;
+        }
+
+        /* Refill the pool with a single re-key of the generator */
+        if (pool->posn >= ASCON_RANDOM_POOL_SIZE) {
+            ascon_random_fetch(&(pool->prng), pool->pool, sizeof(pool->pool));
+            pool->posn = 0;
+        }
+
+        /* Return bytes from the pool and wipe them as we go */
+        temp = ASCON_RANDOM_POOL_SIZE - pool->posn;
+        if (temp > outlen)
+            temp = outlen;
+        memcpy(out, pool->pool + pool->posn, temp);
+        ascon_clean(pool->pool + pool->posn, (unsigned)temp);
+        pool->posn += (unsigned)temp;
+        out += temp;
+        outlen -= temp;
+    }
+}
+
+int ascon_random_pool_reseed(ascon_random_pool_t *pool)
+{
+    if (pool) {
+        ascon_random_pool_discard(pool);
+        return ascon_random_reseed(&(pool->prng));
+    }
+    return 0;
+}
+
+void ascon_random_pool_feed
+    (ascon_random_pool_t *pool, const unsigned char *entropy, size_t size)
+{
+    if (pool) {
+        ascon_random_pool_discard(pool);
+        ascon_random_feed(&(pool->prng), entropy, size);
+    }
+}
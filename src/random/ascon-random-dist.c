@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2022 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <ascon/random-dist.h>
+#include <ascon/utility.h>
+#include "core/ascon-util.h"
+#include <string.h>
+
+/**
+ * \brief Number of values to generate at once when filling an array
+ * whose element type is not the same size as its random input.
+ */
+#define ASCON_RANDOM_DIST_CHUNK 64
+
+uint32_t ascon_random_pool_uint32(ascon_random_pool_t *pool)
+{
+    unsigned char data[4];
+    ascon_random_pool_fetch(pool, data, sizeof(data));
+    return le_load_word32(data);
+}
+
+uint64_t ascon_random_pool_uint64(ascon_random_pool_t *pool)
+{
+    unsigned char data[8];
+    ascon_random_pool_fetch(pool, data, sizeof(data));
+    return le_load_word64(data);
+}
+
+/**
+ * \brief Maps a random 32-bit value into the range 0 to n - 1 using
+ * Lemire's method, drawing more values from the pool if necessary.
+ *
+ * \param pool The buffered pseudorandom number generator.
+ * \param x The initial random 32-bit value.
+ * \param n The size of the range, which must be non-zero.
+ *
+ * \return The random value in the range.
+ */
+static uint32_t ascon_random_pool_lemire32
+    (ascon_random_pool_t *pool, uint32_t x, uint32_t n)
+{
+    uint64_t m = ((uint64_t)x) * n;
+    uint32_t low = (uint32_t)m;
+    uint32_t threshold;
+    if (low < n) {
+        /* Only divide when a rejection is possible */
+        threshold = (0U - n) % n;
+        while (low < threshold) {
+            x = ascon_random_pool_uint32(pool);
+            m = ((uint64_t)x) * n;
+            low = (uint32_t)m;
+        }
+    }
+    return (uint32_t)(m >> 32);
+}
+
+uint32_t ascon_random_pool_range(ascon_random_pool_t *pool, uint32_t n)
+{
+    if (n == 0)
+        return 0;
+    return ascon_random_pool_lemire32(pool, ascon_random_pool_uint32(pool), n);
+}
+
+/**
+ * \brief Multiplies two 64-bit values to produce a 128-bit result.
+ *
+ * \param x The first value.
+ * \param y The second value.
+ * \param low Returns the low 64 bits of the result.
+ *
+ * \return The high 64 bits of the result.
+ */
+static uint64_t ascon_random_mul128(uint64_t x, uint64_t y, uint64_t *low)
+{
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 m = ((unsigned __int128)x) * y;
+    *low = (uint64_t)m;
+    return (uint64_t)(m >> 64);
+#else
+    uint64_t x0 = (uint32_t)x, x1 = x >> 32;
+    uint64_t y0 = (uint32_t)y, y1 = y >> 32;
+    uint64_t p00 = x0 * y0;
+    uint64_t p01 = x0 * y1;
+    uint64_t p10 = x1 * y0;
+    uint64_t p11 = x1 * y1;
+    uint64_t mid = (p00 >> 32) + (uint32_t)p01 + (uint32_t)p10;
+    *low = (mid << 32) | (uint32_t)p00;
+    return p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+#endif
+}
+
+uint64_t ascon_random_pool_range64(ascon_random_pool_t *pool, uint64_t n)
+{
+    uint64_t high, low, threshold;
+    if (n <= 0xFFFFFFFFU)
+        return ascon_random_pool_range(pool, (uint32_t)n);
+    high = ascon_random_mul128(ascon_random_pool_uint64(pool), n, &low);
+    if (low < n) {
+        threshold = (0 - n) % n;
+        while (low < threshold) {
+            high = ascon_random_mul128
+                (ascon_random_pool_uint64(pool), n, &low);
+        }
+    }
+    return high;
+}
+
+double ascon_random_pool_double(ascon_random_pool_t *pool)
+{
+    return (ascon_random_pool_uint64(pool) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+float ascon_random_pool_float(ascon_random_pool_t *pool)
+{
+    return (ascon_random_pool_uint32(pool) >> 8) * (1.0f / 16777216.0f);
+}
+
+void ascon_random_pool_fill_uint32
+    (ascon_random_pool_t *pool, uint32_t *out, size_t count)
+{
+    unsigned char *data = (unsigned char *)out;
+    size_t index;
+
+    /* Squeeze all of the data in one request and then convert the
+     * words in-place from little-endian to host byte order */
+    ascon_random_pool_fetch(pool, data, count * sizeof(uint32_t));
+    for (index = 0; index < count; ++index, data += 4)
+        out[index] = le_load_word32(data);
+}
+
+void ascon_random_pool_fill_range
+    (ascon_random_pool_t *pool, uint32_t *out, size_t count, uint32_t n)
+{
+    size_t index;
+    if (n == 0) {
+        memset(out, 0, count * sizeof(uint32_t));
+        return;
+    }
+    ascon_random_pool_fill_uint32(pool, out, count);
+    for (index = 0; index < count; ++index)
+        out[index] = ascon_random_pool_lemire32(pool, out[index], n);
+}
+
+void ascon_random_pool_fill_double
+    (ascon_random_pool_t *pool, double *out, size_t count)
+{
+    unsigned char data[ASCON_RANDOM_DIST_CHUNK * 8];
+    size_t index, len;
+    while (count > 0) {
+        len = count;
+        if (len > ASCON_RANDOM_DIST_CHUNK)
+            len = ASCON_RANDOM_DIST_CHUNK;
+        ascon_random_pool_fetch(pool, data, len * 8);
+        for (index = 0; index < len; ++index) {
+            out[index] = (le_load_word64(data + index * 8) >> 11) *
+                         (1.0 / 9007199254740992.0);
+        }
+        out += len;
+        count -= len;
+    }
+    ascon_clean(data, sizeof(data));
+}
+
+void ascon_random_pool_shuffle
+    (ascon_random_pool_t *pool, void *array, size_t count, size_t size)
+{
+    unsigned char *base = (unsigned char *)array;
+    unsigned char *a;
+    unsigned char *b;
+    unsigned char temp;
+    size_t index, posn, swap;
+    for (index = count; index > 1; --index) {
+        swap = (size_t)ascon_random_pool_range64(pool, index);
+        if (swap == (index - 1))
+            continue;
+        a = base + (index - 1) * size;
+        b = base + swap * size;
+        for (posn = 0; posn < size; ++posn) {
+            temp = a[posn];
+            a[posn] = b[posn];
+            b[posn] = temp;
+        }
+    }
+}
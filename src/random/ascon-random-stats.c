@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2023 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "random/ascon-random-stats.h"
+#include <string.h>
+
+#if defined(ASCON_RANDOM_STATS)
+
+ascon_random_stats_t ascon_random_global_stats;
+
+int ascon_random_get_stats(ascon_random_stats_t *stats)
+{
+    if (stats) {
+        stats->trng_requests = ascon_random_stats_get(trng_requests);
+        stats->trng_bytes = ascon_random_stats_get(trng_bytes);
+        stats->trng_syscalls = ascon_random_stats_get(trng_syscalls);
+        stats->reseeds = ascon_random_stats_get(reseeds);
+        stats->auto_reseeds = ascon_random_stats_get(auto_reseeds);
+        stats->rekeys = ascon_random_stats_get(rekeys);
+        stats->mixer_permutations = ascon_random_stats_get(mixer_permutations);
+    }
+    return 1;
+}
+
+void ascon_random_reset_stats(void)
+{
+    ascon_random_stats_clear(trng_requests);
+    ascon_random_stats_clear(trng_bytes);
+    ascon_random_stats_clear(trng_syscalls);
+    ascon_random_stats_clear(reseeds);
+    ascon_random_stats_clear(auto_reseeds);
+    ascon_random_stats_clear(rekeys);
+    ascon_random_stats_clear(mixer_permutations);
+}
+
+#else /* !ASCON_RANDOM_STATS */
+
+int ascon_random_get_stats(ascon_random_stats_t *stats)
+{
+    if (stats)
+        memset(stats, 0, sizeof(ascon_random_stats_t));
+    return 0;
+}
+
+void ascon_random_reset_stats(void)
+{
+}
+
+#endif /* !ASCON_RANDOM_STATS */
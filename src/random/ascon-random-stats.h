@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2023 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef ASCON_RANDOM_STATS_H
+#define ASCON_RANDOM_STATS_H
+
+/**
+ * \file ascon-random-stats.h
+ * \brief Instrumentation counters for the random number sources.
+ *
+ * This is not a public API and should only be used by the library itself.
+ * Applications should use ascon_random_get_stats() instead.
+ *
+ * The counters are compiled in when ASCON_RANDOM_STATS is defined.
+ * Otherwise the macros in this file expand to nothing.
+ */
+
+#include <ascon/random.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(ASCON_RANDOM_STATS)
+
+/**
+ * \brief Global instrumentation counters for the random number sources.
+ */
+extern ascon_random_stats_t ascon_random_global_stats;
+
+/* Counters may be updated from several threads at once.  Use relaxed
+ * atomics if the compiler has them for 64-bit values.  Otherwise the
+ * counters are approximate when multiple threads are in use. */
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_8)
+#define ascon_random_stats_add(field, n) \
+    ((void)__atomic_fetch_add \
+        (&(ascon_random_global_stats.field), (uint64_t)(n), __ATOMIC_RELAXED))
+#define ascon_random_stats_get(field) \
+    (__atomic_load_n(&(ascon_random_global_stats.field), __ATOMIC_RELAXED))
+#define ascon_random_stats_clear(field) \
+    (__atomic_store_n \
+        (&(ascon_random_global_stats.field), 0, __ATOMIC_RELAXED))
+#else
+#define ascon_random_stats_add(field, n) \
+    ((void)(ascon_random_global_stats.field += (uint64_t)(n)))
+#define ascon_random_stats_get(field) (ascon_random_global_stats.field)
+#define ascon_random_stats_clear(field) \
+    ((void)(ascon_random_global_stats.field = 0))
+#endif
+
+#else /* !ASCON_RANDOM_STATS */
+
+#define ascon_random_stats_add(field, n) do { ; } while (0)
+
+#endif /* !ASCON_RANDOM_STATS */
+
+/**
+ * \brief Counts a request for seed material from the system TRNG.
+ *
+ * \param len Number of bytes that were requested.
+ */
+#define ascon_random_stats_trng(len) \
+    do { \
+        ascon_random_stats_add(trng_requests, 1); \
+        ascon_random_stats_add(trng_bytes, (len)); \
+    } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
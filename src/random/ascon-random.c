@@ -24,7 +24,210 @@
 #include <ascon/utility.h>
 #include "random/ascon-trng.h"
 
-int ascon_random(unsigned char *out, size_t outlen)
+#if defined(HAVE_CONFIG_H)
+#include <config.h>
+#endif
+
+/* Determine if we can keep a separate PRNG shard for each thread */
+#if defined(HAVE_THREAD_KEYWORD)
+#define THREAD_LOCAL __thread
+#define ASCON_RANDOM_SHARDS 1
+#elif defined(HAVE_THREAD_LOCAL_KEYWORD)
+#define THREAD_LOCAL _Thread_local
+#define ASCON_RANDOM_SHARDS 1
+#endif
+
+/* Determine how to detect that the process has forked.  A handler
+ * registered with pthread_atfork() is cheapest because it avoids a
+ * system call on every request.  Otherwise compare process identifiers.
+ * With pthreads we can also wipe the shard when the thread exits. */
+#if defined(ASCON_RANDOM_SHARDS)
+#if defined(HAVE_PTHREAD_H) && defined(HAVE_LIBPTHREAD)
+#include <pthread.h>
+#define ASCON_RANDOM_PTHREAD 1
+#elif defined(HAVE_GETPID) && defined(HAVE_UNISTD_H)
+#include <sys/types.h>
+#include <unistd.h>
+#define ASCON_RANDOM_GETPID 1
+#endif
+#endif
+
+#if defined(ASCON_RANDOM_SHARDS)
+
+#if defined(ASCON_RANDOM_PTHREAD)
+typedef unsigned long ascon_random_fork_id_t;
+#elif defined(ASCON_RANDOM_GETPID)
+typedef pid_t ascon_random_fork_id_t;
+#else
+typedef int ascon_random_fork_id_t;
+#endif
+
+/**
+ * \brief Shard of the process-wide PRNG that belongs to a single thread.
+ *
+ * The PRNG is seeded from the system TRNG on first use.  Thereafter, it
+ * is periodically re-seeded from the TRNG and re-keyed on every refill
+ * of the pool.  Bytes are wiped from the pool as they are returned, so
+ * the state left behind by an exited thread cannot be used to recover
+ * earlier output.
+ */
+typedef struct
+{
+    ascon_random_pool_t pool;       /**< Buffered PRNG for this thread */
+    ascon_random_fork_id_t fork_id; /**< Process when the shard was seeded */
+    unsigned long epoch;            /**< Re-seed epoch of the shard */
+    int seeded;                     /**< Non-zero once the shard is seeded */
+    int ok;                         /**< Result of the last TRNG request */
+
+} ascon_random_shard_t;
+
+/**
+ * \brief PRNG shard for the current thread.
+ *
+ * Each thread only ever touches its own shard so no locking is required.
+ */
+static THREAD_LOCAL ascon_random_shard_t ascon_random_shard;
+
+/**
+ * \brief Global re-seed epoch.  Incrementing this asks every shard to
+ * re-seed from the TRNG the next time that it is used.
+ */
+static volatile unsigned long ascon_random_epoch = 0;
+
+/* Many threads read the epoch and any thread can increment it, so use
+ * atomics if the compiler has them.  Otherwise fall back to volatile,
+ * where concurrent increments may be lost but the value will still
+ * differ from the epoch that was recorded in each shard. */
+#if defined(__GCC_ATOMIC_LONG_LOCK_FREE) && __GCC_ATOMIC_LONG_LOCK_FREE == 2
+#define ascon_random_epoch_get() \
+    (__atomic_load_n(&ascon_random_epoch, __ATOMIC_ACQUIRE))
+#define ascon_random_epoch_next() \
+    ((void)__atomic_fetch_add(&ascon_random_epoch, 1UL, __ATOMIC_RELEASE))
+#else
+#define ascon_random_epoch_get() (ascon_random_epoch)
+#define ascon_random_epoch_next() ((void)(++ascon_random_epoch))
+#endif
+
+#if defined(ASCON_RANDOM_PTHREAD)
+
+/**
+ * \brief Number of times that the process has forked.
+ */
+static volatile unsigned long ascon_random_forks = 0;
+
+static pthread_once_t ascon_random_once = PTHREAD_ONCE_INIT;
+
+static pthread_key_t ascon_random_key;
+
+/**
+ * \brief Non-zero if ascon_random_key was created successfully.
+ */
+static int ascon_random_key_ok = 0;
+
+static void ascon_random_child(void)
+{
+    /* Only the forking thread exists in the child at this point */
+    ++ascon_random_forks;
+}
+
+static void ascon_random_thread_exit(void *arg)
+{
+    ascon_random_shard_t *shard = (ascon_random_shard_t *)arg;
+    ascon_random_pool_free(&(shard->pool));
+    shard->seeded = 0;
+}
+
+static void ascon_random_setup(void)
+{
+    pthread_atfork(0, 0, ascon_random_child);
+    /* If we cannot create the key, then shards will not be wiped when
+     * their threads exit but everything else will still work */
+    if (pthread_key_create(&ascon_random_key, ascon_random_thread_exit) == 0)
+        ascon_random_key_ok = 1;
+}
+
+#define ascon_random_fork_id() (ascon_random_forks)
+
+#elif defined(ASCON_RANDOM_GETPID)
+
+#define ascon_random_fork_id() (getpid())
+
+#else
+
+#define ascon_random_fork_id() 0
+
+#endif
+
+/**
+ * \brief Gets the PRNG shard for the current thread, seeding or
+ * re-seeding it as necessary.
+ *
+ * \return A pointer to the shard.
+ */
+static ascon_random_shard_t *ascon_random_get_shard(void)
+{
+    ascon_random_shard_t *shard = &ascon_random_shard;
+    ascon_random_fork_id_t fork_id;
+    unsigned long epoch;
+
+#if defined(ASCON_RANDOM_PTHREAD)
+    pthread_once(&ascon_random_once, ascon_random_setup);
+#endif
+    fork_id = ascon_random_fork_id();
+    epoch = ascon_random_epoch_get();
+
+    /* Start again from scratch in a child process so that we do not
+     * repeat the output of the parent process */
+    if (shard->seeded && shard->fork_id != fork_id) {
+        ascon_random_pool_free(&(shard->pool));
+        shard->seeded = 0;
+    }
+
+    /* Seed the shard on first use */
+    if (!shard->seeded) {
+        shard->ok = ascon_random_pool_init(&(shard->pool));
+        shard->fork_id = fork_id;
+        shard->epoch = epoch;
+        shard->seeded = 1;
+#if defined(ASCON_RANDOM_PTHREAD)
+        if (ascon_random_key_ok)
+            pthread_setspecific(ascon_random_key, shard);
+#endif
+    }
+
+    /* Re-seed if someone has asked for all shards to be re-seeded */
+    if (shard->epoch != epoch) {
+        shard->ok = ascon_random_pool_reseed(&(shard->pool));
+        shard->epoch = epoch;
+    }
+    return shard;
+}
+
+int ascon_random_shared_fetch(unsigned char *out, size_t outlen)
+{
+    ascon_random_shard_t *shard = ascon_random_get_shard();
+    ascon_random_pool_fetch(&(shard->pool), out, outlen);
+    return shard->ok ? 1 : 0;
+}
+
+int ascon_random_shared_reseed(void)
+{
+    ascon_random_epoch_next();
+    return ascon_random_get_shard()->ok ? 1 : 0;
+}
+
+void ascon_random_shared_release(void)
+{
+    ascon_random_shard_t *shard = &ascon_random_shard;
+    if (shard->seeded) {
+        ascon_random_pool_free(&(shard->pool));
+        shard->seeded = 0;
+    }
+}
+
+#else /* !ASCON_RANDOM_SHARDS */
+
+int ascon_random_shared_fetch(unsigned char *out, size_t outlen)
 {
     ascon_xof_state_t xof;
     unsigned char seed[ASCON_SYSTEM_SEED_SIZE];
@@ -36,3 +239,25 @@ int ascon_random(unsigned char *out, size_t outlen)
     ascon_clean(seed, sizeof(seed));
     return ok ? 1 : 0;
 }
+
+int ascon_random_shared_reseed(void)
+{
+    /* Every request is seeded directly from the TRNG, so all we need
+     * to do is check that the TRNG is working */
+    unsigned char seed[ASCON_SYSTEM_SEED_SIZE];
+    int ok = ascon_trng_generate(seed, sizeof(seed));
+    ascon_clean(seed, sizeof(seed));
+    return ok ? 1 : 0;
+}
+
+void ascon_random_shared_release(void)
+{
+    /* Nothing to do because there is no per-thread state */
+}
+
+#endif /* !ASCON_RANDOM_SHARDS */
+
+int ascon_random(unsigned char *out, size_t outlen)
+{
+    return ascon_random_shared_fetch(out, outlen);
+}
@@ -22,6 +22,7 @@
 
 #define _GNU_SOURCE
 #include "ascon-trng.h"
+#include "ascon-random-stats.h"
 #include "core/ascon-select-backend.h"
 
 #if defined(ASCON_TRNG_DEV_RANDOM)
@@ -58,6 +59,7 @@
 #if !defined(ascon_getrandom)
 static int ascon_dev_random_open(void)
 {
+    ascon_random_stats_add(trng_syscalls, 1);
     return open(RANDOM_DEVICE, O_RDONLY);
 }
 #else
@@ -70,7 +72,9 @@ static int ascon_dev_random_read(int fd, unsigned char *out, size_t outlen)
     /* Keep looping until we get some data or a permanent error. */
     (void)fd;
     for (;;) {
-        int ret = ascon_getrandom(out, outlen);
+        int ret;
+        ascon_random_stats_add(trng_syscalls, 1);
+        ret = ascon_getrandom(out, outlen);
         if (ret >= 0) {
             /* getentropy() returns 0 on success, getrandom() returns
              * the number of bytes read on success */
@@ -88,7 +92,9 @@ static int ascon_dev_random_read(int fd, unsigned char *out, size_t outlen)
     if (fd >= 0) {
         /* Keep looping until we get some data or a permanent error. */
         for (;;) {
-            int ret = read(fd, out, outlen);
+            int ret;
+            ascon_random_stats_add(trng_syscalls, 1);
+            ret = read(fd, out, outlen);
             if (ret == (int)outlen) {
                 return 1;
             } else if (ret < 0) {
@@ -106,12 +112,17 @@ static int ascon_dev_random_read(int fd, unsigned char *out, size_t outlen)
 int ascon_trng_generate(unsigned char *out, size_t outlen)
 {
 #if defined(ascon_getrandom)
+    ascon_random_stats_trng(outlen);
     return ascon_dev_random_read(-1, out, outlen);
 #else
-    int fd = ascon_dev_random_open();
-    int ok = ascon_dev_random_read(fd, out, outlen);
-    if (fd >= 0)
+    int fd, ok;
+    ascon_random_stats_trng(outlen);
+    fd = ascon_dev_random_open();
+    ok = ascon_dev_random_read(fd, out, outlen);
+    if (fd >= 0) {
+        ascon_random_stats_add(trng_syscalls, 1);
         close(fd);
+    }
     return ok;
 #endif
 }
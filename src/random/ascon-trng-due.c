@@ -21,6 +21,7 @@
  */
 
 #include "ascon-trng.h"
+#include "ascon-random-stats.h"
 #include <string.h>
 
 #if defined(ASCON_TRNG_DUE)
@@ -59,6 +60,7 @@ int ascon_trng_generate(unsigned char *out, size_t outlen)
 {
     uint32_t x;
     int ok = 1;
+    ascon_random_stats_trng(outlen);
     ascon_trng_init_internal();
     while (outlen >= sizeof(x)) {
         if (!ascon_trng_generate_word(&x))
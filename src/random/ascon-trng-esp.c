@@ -21,6 +21,7 @@
  */
 
 #include "ascon-trng.h"
+#include "ascon-random-stats.h"
 #include <string.h>
 
 #if defined(ASCON_TRNG_ESP)
@@ -37,6 +38,7 @@ extern uint32_t esp_random(void);
 int ascon_trng_generate(unsigned char *out, size_t outlen)
 {
     uint32_t x;
+    ascon_random_stats_trng(outlen);
     while (outlen >= sizeof(x)) {
         x = esp_random();
         memcpy(out, &x, sizeof(x));
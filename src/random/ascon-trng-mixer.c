@@ -21,7 +21,9 @@
  */
 
 #include "ascon-trng.h"
+#include "ascon-random-stats.h"
 #include "core/ascon-select-backend.h"
+#include "core/ascon-permute-2way.h"
 #include <ascon/utility.h>
 
 /* Used on platforms that don't have a simple "get random word" primitive.
@@ -39,6 +41,7 @@ int ascon_trng_init(ascon_trng_state_t *state)
         (&(state->prng), seed, 40 - sizeof(seed), sizeof(seed));
     ascon_permute12(&(state->prng));
     ascon_release(&(state->prng));
+    ascon_random_stats_add(mixer_permutations, 1);
     ascon_clean(seed, sizeof(seed));
     state->posn = 0;
     return ok;
@@ -56,6 +59,7 @@ uint32_t ascon_trng_generate_32(ascon_trng_state_t *state)
     ascon_acquire(&(state->prng));
     if ((state->posn + sizeof(uint32_t)) > ASCON_TRNG_MIXER_RATE) {
         ascon_permute6(&(state->prng));
+        ascon_random_stats_add(mixer_permutations, 1);
         state->posn = 0;
     }
 #if defined(ASCON_BACKEND_SLICED32) || defined(ASCON_BACKEND_SLICED64) || \
@@ -79,6 +83,7 @@ uint64_t ascon_trng_generate_64(ascon_trng_state_t *state)
     if ((state->posn + sizeof(uint64_t)) > ASCON_TRNG_MIXER_RATE ||
             (state->posn % 8U) != 0) {
         ascon_permute6(&(state->prng));
+        ascon_random_stats_add(mixer_permutations, 1);
         state->posn = 0;
     }
 #if defined(ASCON_BACKEND_SLICED32) || defined(ASCON_BACKEND_SLICED64) || \
@@ -95,6 +100,58 @@ uint64_t ascon_trng_generate_64(ascon_trng_state_t *state)
     return x;
 }
 
+/* Extracts the first 64-bit word of the rate from a mixer state */
+#if defined(ASCON_BACKEND_SLICED32) || defined(ASCON_BACKEND_SLICED64) || \
+        defined(ASCON_BACKEND_DIRECT_XOR)
+#define ascon_trng_mixer_word(state, x) ((x) = (state)->S[0])
+#else
+#define ascon_trng_mixer_word(state, x) \
+    ascon_extract_bytes((state), (unsigned char *)&(x), 0, sizeof(x))
+#endif
+
+void ascon_trng_generate_words_64
+    (ascon_trng_state_t *state, uint64_t *out, size_t count)
+{
+#if defined(ASCON_PERMUTE_2WAY)
+    /* Fork a second lane off the mixer state, separated from the main
+     * lane by a constant in the capacity.  Both lanes are then permuted
+     * side by side and each call produces two words.  The second lane
+     * is thrown away at the end. */
+    if (count >= 2) {
+        static unsigned char const lane_id = 0x01;
+        ascon_state_t lane;
+        ascon_init(&lane);
+        ascon_copy(&lane, &(state->prng));
+        ascon_add_bytes(&lane, &lane_id, 39, 1);
+        ascon_acquire(&(state->prng));
+        while (count >= 2) {
+            ascon_permute_2way(&(state->prng), &lane, 6);
+            ascon_random_stats_add(mixer_permutations, 2);
+            ascon_trng_mixer_word(&(state->prng), out[0]);
+            ascon_trng_mixer_word(&lane, out[1]);
+            out += 2;
+            count -= 2;
+        }
+        ascon_free(&lane);
+    } else {
+        ascon_acquire(&(state->prng));
+    }
+#else
+    ascon_acquire(&(state->prng));
+#endif
+    while (count > 0) {
+        ascon_permute6(&(state->prng));
+        ascon_random_stats_add(mixer_permutations, 1);
+        ascon_trng_mixer_word(&(state->prng), out[0]);
+        ++out;
+        --count;
+    }
+    ascon_release(&(state->prng));
+
+    /* The current rate block has been used up */
+    state->posn = ASCON_TRNG_MIXER_RATE;
+}
+
 int ascon_trng_reseed(ascon_trng_state_t *state)
 {
     unsigned char seed[ASCON_SYSTEM_SEED_SIZE];
@@ -104,9 +161,22 @@ int ascon_trng_reseed(ascon_trng_state_t *state)
     ascon_overwrite_with_zeroes(&(state->prng), 0, 8); /* Forward security */
     ascon_permute12(&(state->prng));
     ascon_release(&(state->prng));
+    ascon_random_stats_add(mixer_permutations, 1);
     ascon_clean(seed, sizeof(seed));
     state->posn = 0;
     return ok;
 }
 
-#endif /* ASCON_TRNG_MIXER */
+#else /* !ASCON_TRNG_MIXER */
+
+void ascon_trng_generate_words_64
+    (ascon_trng_state_t *state, uint64_t *out, size_t count)
+{
+    /* The TRNG has a fast "get random word" primitive so use it directly */
+    while (count > 0) {
+        *out++ = ascon_trng_generate_64(state);
+        --count;
+    }
+}
+
+#endif /* !ASCON_TRNG_MIXER */
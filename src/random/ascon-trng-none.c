@@ -21,6 +21,7 @@
  */
 
 #include "ascon-trng.h"
+#include "ascon-random-stats.h"
 #include <ascon/utility.h>
 #include <string.h>
 
@@ -194,6 +195,8 @@ int ascon_trng_generate(unsigned char *out, size_t outlen)
     unsigned char seed[ASCON_SYSTEM_SEED_SIZE];
     int ok;
 
+    ascon_random_stats_trng(outlen);
+
     /* Re-seed and squeeze some data out of the global PRNG */
     ok = ascon_trng_global_init(seed);
     ascon_trng_squeeze(&global_prng, out, outlen);
@@ -21,6 +21,7 @@
  */
 
 #include "ascon-trng.h"
+#include "ascon-random-stats.h"
 #include <string.h>
 
 #if defined(ASCON_TRNG_STM32_ENABLED)
@@ -31,6 +32,7 @@ int ascon_trng_generate(unsigned char *out, size_t outlen)
 {
     uint32_t x;
     int ok = 1;
+    ascon_random_stats_trng(outlen);
     while (outlen >= sizeof(x)) {
         if (HAL_RNG_GenerateRandomNumber(&ASCON_TRNG_STM32, &x) != HAL_OK) {
             x = 0xABADBEEF; /* This is a problem! */
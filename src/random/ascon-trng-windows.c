@@ -21,6 +21,7 @@
  */
 
 #include "ascon-trng.h"
+#include "ascon-random-stats.h"
 #include "core/ascon-select-backend.h"
 #include <string.h>
 
@@ -39,6 +40,8 @@ int ascon_trng_generate(unsigned char *out, size_t outlen)
 {
     HCRYPTPROV provider = 0;
     int ok = 0;
+    ascon_random_stats_trng(outlen);
+    ascon_random_stats_add(trng_syscalls, 1);
     if (CryptAcquireContextW
             (&provider, 0, 0, PROV_RSA_FULL,
              CRYPT_VERIFYCONTEXT | CRYPT_SILENT)) {
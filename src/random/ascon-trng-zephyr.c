@@ -21,6 +21,7 @@
  */
 
 #include "ascon-trng.h"
+#include "ascon-random-stats.h"
 #include "core/ascon-select-backend.h"
 #include <string.h>
 
@@ -30,6 +31,9 @@
 
 int ascon_trng_generate(unsigned char *out, size_t outlen)
 {
+    ascon_random_stats_trng(outlen);
+    ascon_random_stats_add(trng_syscalls, 1);
+
     /* Try to get random data from the Zephyr kernel */
     if (sys_csrand_get(out, outlen) == 0)
         return 1;
@@ -45,6 +49,9 @@ int ascon_trng_generate(unsigned char *out, size_t outlen)
 
 int ascon_trng_generate(unsigned char *out, size_t outlen)
 {
+    ascon_random_stats_trng(outlen);
+    ascon_random_stats_add(trng_syscalls, 1);
+
     /* Try to get random data from the Bluetooth stack */
     if (bt_rand(out, outlen) == 0)
         return 1;
@@ -132,6 +132,25 @@ uint32_t ascon_trng_generate_32(ascon_trng_state_t *state);
  */
 uint64_t ascon_trng_generate_64(ascon_trng_state_t *state);
 
+/**
+ * \brief Generates a batch of 64-bit random values for masking operations.
+ *
+ * \param state State information for the source.
+ * \param out Points to the array to fill with random values.
+ * \param count Number of random values to generate.
+ *
+ * The output has the same distribution as calling ascon_trng_generate_64()
+ * \a count times, but it is not the same sequence of values.  The source
+ * only needs to be acquired once.  On some platforms, pairs of values are
+ * generated from a second lane that is forked off the state and run with
+ * interleaved permutation calls.  Any unused output in the current rate
+ * block is discarded.
+ * Masked code that needs several random words at once should call this
+ * and then consume the words from the array.
+ */
+void ascon_trng_generate_words_64
+    (ascon_trng_state_t *state, uint64_t *out, size_t count);
+
 /**
  * \brief Reseeds the random number source.
  *
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2023 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Benchmark for the keyed hash in <ascon/keyed-hash.h>.  Compares the
+ * cost of hashing with ASCON-PrfShort against the cost of looking up
+ * keys in a hash table that uses std::hash or ascon::keyed_hash.
+ */
+
+#include <ascon/keyed-hash.h>
+#include <ascon/prf.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+extern "C" {
+#include "timing.h"
+}
+
+#define BENCH_TABLE_SIZE 4096
+#define BENCH_LOOPS 200000
+
+static unsigned char const bench_key[ASCON_KEYED_HASH_KEY_SIZE] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F
+};
+
+static volatile uint64_t bench_sink;
+
+static void report(const char *name, perf_timer_t elapsed, unsigned long count)
+{
+    double secs = ((double)elapsed) / perf_timer_ticks_per_second();
+    printf("%-36s%10.2f ns/op\n", name, (secs * 1e9) / count);
+}
+
+static void bench_hash_only(void)
+{
+    ascon_keyed_hash_key_t key;
+    unsigned char out[8];
+    unsigned char in[16];
+    perf_timer_t start;
+    uint64_t sum = 0;
+    unsigned long index;
+
+    ascon_keyed_hash_key_init(&key, bench_key);
+    memset(in, 0xA5, sizeof(in));
+
+    start = perf_timer_get_time();
+    for (index = 0; index < BENCH_LOOPS; ++index) {
+        ascon_prf_short(out, sizeof(out), in, 8, bench_key);
+        sum += out[0];
+    }
+    report("ascon_prf_short, 8 bytes", perf_timer_get_time() - start, BENCH_LOOPS);
+
+    start = perf_timer_get_time();
+    for (index = 0; index < BENCH_LOOPS; ++index)
+        sum += ascon_keyed_hash64(&key, in, 8);
+    report("ascon_keyed_hash64, 8 bytes", perf_timer_get_time() - start, BENCH_LOOPS);
+
+    start = perf_timer_get_time();
+    for (index = 0; index < BENCH_LOOPS; ++index)
+        sum += ascon_keyed_hash64_u64(&key, index);
+    report("ascon_keyed_hash64_u64", perf_timer_get_time() - start, BENCH_LOOPS);
+
+    start = perf_timer_get_time();
+    for (index = 0; index < BENCH_LOOPS; ++index)
+        sum += ascon_keyed_hash64_u128(&key, index, ~index);
+    report("ascon_keyed_hash64_u128", perf_timer_get_time() - start, BENCH_LOOPS);
+
+    start = perf_timer_get_time();
+    for (index = 0; index < BENCH_LOOPS; ++index)
+        sum += ascon_keyed_hash64(&key, in, 16);
+    report("ascon_keyed_hash64, 16 bytes", perf_timer_get_time() - start, BENCH_LOOPS);
+
+    bench_sink = sum;
+    ascon_keyed_hash_key_free(&key);
+}
+
+template <typename Key, typename Hasher>
+static void bench_lookup
+    (const char *name, const std::vector<Key> &keys, const Hasher &hasher)
+{
+    std::unordered_map<Key, unsigned long, Hasher> table
+        (BENCH_TABLE_SIZE, hasher);
+    perf_timer_t start;
+    uint64_t sum = 0;
+    unsigned long index;
+
+    for (index = 0; index < keys.size(); ++index)
+        table[keys[index]] = index;
+
+    start = perf_timer_get_time();
+    for (index = 0; index < BENCH_LOOPS; ++index)
+        sum += table.find(keys[index % keys.size()])->second;
+    report(name, perf_timer_get_time() - start, BENCH_LOOPS);
+    bench_sink = sum;
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<uint64_t> int_keys;
+    std::vector<std::string> string_keys;
+    ascon::keyed_hash keyed(bench_key);
+    unsigned long index;
+    char name[32];
+
+    (void)argc;
+    (void)argv;
+
+    if (!perf_timer_init()) {
+        fprintf(stderr, "do not know how to time events on this system\n");
+        return 1;
+    }
+
+    for (index = 0; index < BENCH_TABLE_SIZE; ++index) {
+        int_keys.push_back(index * 0x9E3779B97F4A7C15ULL);
+        snprintf(name, sizeof(name), "key-%lu", index);
+        string_keys.push_back(std::string(name));
+    }
+
+    bench_hash_only();
+    bench_lookup("lookup uint64_t, std::hash", int_keys, std::hash<uint64_t>());
+    bench_lookup("lookup uint64_t, ascon::keyed_hash", int_keys, keyed);
+    bench_lookup("lookup string, std::hash", string_keys, std::hash<std::string>());
+    bench_lookup("lookup string, ascon::keyed_hash", string_keys, keyed);
+    return 0;
+}
@@ -21,61 +21,22 @@
  */
 
 #include "timing.h"
-#include <time.h>
+#include "core/ascon-timing.h"
 
-/* Timers that we currently know about */
-#define PERF_TIMER_UNKNOWN 0
-#define PERF_TIMER_CLOCK_GETTIME 1
-
-/*
- * Detect the timer implementation to use.
- *
- * We prefer to use the high-resolution CLOCK_THREAD_CPUTIME_ID or
- * CLOCK_PROCESS_CPUTIME_ID timers because the kernel will take care of
- * factoring out the time spent in other processes for us.  It will
- * also handle thread migration between CPU's in SMP systems.
- */
-#if defined(CLOCK_THREAD_CPUTIME_ID)
-    #define PERF_TIMER PERF_TIMER_CLOCK_GETTIME
-    #define PERF_TIMER_NAME CLOCK_THREAD_CPUTIME_ID
-#elif defined(CLOCK_PROCESS_CPUTIME_ID)
-    #define PERF_TIMER PERF_TIMER_CLOCK_GETTIME
-    #define PERF_TIMER_NAME CLOCK_PROCESS_CPUTIME_ID
-#elif defined(CLOCK_MONOTONIC_RAW)
-    #define PERF_TIMER PERF_TIMER_CLOCK_GETTIME
-    #define PERF_TIMER_NAME CLOCK_MONOTONIC_RAW
-#elif defined(CLOCK_MONOTONIC)
-    #define PERF_TIMER PERF_TIMER_CLOCK_GETTIME
-    #define PERF_TIMER_NAME CLOCK_MONOTONIC
-#else
-    #define PERF_TIMER PERF_TIMER_UNKNOWN
-#endif
+/* The timer implementation lives in the library so that it can also be
+ * used for calibrating algorithm parameters at runtime */
 
 int perf_timer_init(void)
 {
-#if PERF_TIMER == PERF_TIMER_CLOCK_GETTIME
-    return 1;
-#else
-    return 0;
-#endif
+    return ascon_timer_init();
 }
 
 perf_timer_t perf_timer_get_time(void)
 {
-#if PERF_TIMER == PERF_TIMER_CLOCK_GETTIME
-    struct timespec tv;
-    clock_gettime(PERF_TIMER_NAME, &tv);
-    return tv.tv_sec * 1000000000LL + tv.tv_nsec;
-#else
-    return 0;
-#endif
+    return ascon_timer_get_time();
 }
 
 perf_timer_t perf_timer_ticks_per_second(void)
 {
-#if PERF_TIMER == PERF_TIMER_CLOCK_GETTIME
-    return 1000000000ULL;
-#else
-    return 0;
-#endif
+    return ascon_timer_ticks_per_second();
 }
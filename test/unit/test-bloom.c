@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2023 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <ascon/bloom.h>
+#include <ascon/xof.h>
+#include "test-cipher.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_NUM_KEYS 1000
+#define TEST_NUM_BLOCKS 256
+#define TEST_K 7
+
+static unsigned char test_bits[TEST_NUM_BLOCKS * ASCON_BLOOM_BLOCK_SIZE];
+static unsigned char test_bits2[TEST_NUM_BLOCKS * ASCON_BLOOM_BLOCK_SIZE];
+static unsigned char test_serialized
+    [ASCON_BLOOM_SERIALIZED_SIZE(TEST_NUM_BLOCKS)];
+static unsigned char test_keys[TEST_NUM_KEYS * 2][8];
+static const unsigned char *test_key_ptrs[TEST_NUM_KEYS * 2];
+static size_t test_key_lens[TEST_NUM_KEYS * 2];
+static unsigned char test_results[TEST_NUM_KEYS * 2];
+
+static void report(int ok)
+{
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
+static void test_multi_index(void)
+{
+    static unsigned char const key[] = "multi-index";
+    uint32_t indices[20];
+    unsigned char out[sizeof(indices)];
+    ascon_xof_state_t xof;
+    uint32_t expected;
+    unsigned index;
+    int ok = 1;
+
+    printf("Multi-index ... ");
+    fflush(stdout);
+
+    ascon_multi_index(indices, 20, 1000, key, sizeof(key) - 1);
+    ascon_xof_init_custom(&xof, "MultiIndex", 0, 0, 0);
+    ascon_xof_absorb(&xof, key, sizeof(key) - 1);
+    ascon_xof_squeeze(&xof, out, sizeof(out));
+    ascon_xof_free(&xof);
+    for (index = 0; index < 20; ++index) {
+        expected = ((uint32_t)(out[index * 4]) << 24) |
+                   ((uint32_t)(out[index * 4 + 1]) << 16) |
+                   ((uint32_t)(out[index * 4 + 2]) << 8) |
+                    (uint32_t)(out[index * 4 + 3]);
+        expected = (uint32_t)((expected * (uint64_t)1000) >> 32);
+        if (indices[index] != expected || indices[index] >= 1000)
+            ok = 0;
+    }
+
+    report(ok);
+}
+
+static void test_bloom_insert_query(void)
+{
+    ascon_bloom_filter_t filter;
+    ascon_bloom_filter_t filter2;
+    size_t index, found;
+    int ok = 1;
+
+    printf("Bloom Filter Insert/Query ... ");
+    fflush(stdout);
+
+    /* Insert the first half of the keys one at a time */
+    if (ascon_bloom_init(&filter, test_bits, sizeof(test_bits), TEST_K) != 0)
+        ok = 0;
+    for (index = 0; index < TEST_NUM_KEYS; ++index)
+        ascon_bloom_insert(&filter, test_key_ptrs[index], test_key_lens[index]);
+
+    /* There must be no false negatives and few false positives */
+    found = 0;
+    for (index = 0; index < TEST_NUM_KEYS * 2; ++index) {
+        if (ascon_bloom_contains
+                (&filter, test_key_ptrs[index], test_key_lens[index])) {
+            ++found;
+        } else if (index < TEST_NUM_KEYS) {
+            ok = 0;
+        }
+    }
+    if (found < TEST_NUM_KEYS || found > (TEST_NUM_KEYS + TEST_NUM_KEYS / 20))
+        ok = 0;
+
+    /* Batched insertion must produce the same bits */
+    if (ascon_bloom_init(&filter2, test_bits2, sizeof(test_bits2), TEST_K) != 0)
+        ok = 0;
+    ascon_bloom_insert_batch
+        (&filter2, test_key_ptrs, test_key_lens, TEST_NUM_KEYS);
+    if (test_memcmp(test_bits2, test_bits, sizeof(test_bits)) != 0)
+        ok = 0;
+
+    /* Batched queries must agree with the individual queries */
+    if (ascon_bloom_contains_batch
+            (&filter2, test_results, test_key_ptrs, test_key_lens,
+             TEST_NUM_KEYS * 2) != found)
+        ok = 0;
+    for (index = 0; index < TEST_NUM_KEYS * 2; ++index) {
+        if (test_results[index] != ascon_bloom_contains
+                (&filter, test_key_ptrs[index], test_key_lens[index]))
+            ok = 0;
+    }
+
+    /* Clearing the filter removes all of the keys */
+    ascon_bloom_clear(&filter2);
+    if (ascon_bloom_contains_batch
+            (&filter2, test_results, test_key_ptrs, test_key_lens,
+             TEST_NUM_KEYS) != 0)
+        ok = 0;
+
+    ascon_bloom_free(&filter);
+    ascon_bloom_free(&filter2);
+    report(ok);
+}
+
+static void test_bloom_serialize(void)
+{
+    ascon_bloom_filter_t filter;
+    ascon_bloom_filter_t filter2;
+    size_t index;
+    int ok = 1;
+
+    printf("Bloom Filter Serialization ... ");
+    fflush(stdout);
+
+    /* Round-trip a filter through the serialized form */
+    ascon_bloom_init(&filter, test_bits, sizeof(test_bits), TEST_K);
+    ascon_bloom_insert_batch
+        (&filter, test_key_ptrs, test_key_lens, TEST_NUM_KEYS);
+    if (ascon_bloom_serialize
+            (&filter, test_serialized, sizeof(test_serialized) - 1) != -1)
+        ok = 0;
+    if (ascon_bloom_serialize
+            (&filter, test_serialized, sizeof(test_serialized)) != 0)
+        ok = 0;
+    if (ascon_bloom_deserialize
+            (&filter2, test_bits2, sizeof(test_bits2),
+             test_serialized, sizeof(test_serialized)) != 0)
+        ok = 0;
+    if (filter2.num_blocks != TEST_NUM_BLOCKS || filter2.k != TEST_K)
+        ok = 0;
+    if (test_memcmp(test_bits2, test_bits, sizeof(test_bits)) != 0)
+        ok = 0;
+    for (index = 0; index < TEST_NUM_KEYS; ++index) {
+        if (!ascon_bloom_contains
+                (&filter2, test_key_ptrs[index], test_key_lens[index]))
+            ok = 0;
+    }
+    ascon_bloom_free(&filter2);
+
+    /* Invalid serializations must be rejected */
+    if (ascon_bloom_deserialize
+            (&filter2, test_bits2, sizeof(test_bits2) - 1,
+             test_serialized, sizeof(test_serialized)) != -1)
+        ok = 0;
+    if (ascon_bloom_deserialize
+            (&filter2, test_bits2, sizeof(test_bits2),
+             test_serialized, sizeof(test_serialized) - 1) != -1)
+        ok = 0;
+    test_serialized[0] ^= 0x01;
+    if (ascon_bloom_deserialize
+            (&filter2, test_bits2, sizeof(test_bits2),
+             test_serialized, sizeof(test_serialized)) != -1)
+        ok = 0;
+    test_serialized[0] ^= 0x01;
+    test_serialized[5] = ASCON_BLOOM_MAX_HASHES + 1;
+    if (ascon_bloom_deserialize
+            (&filter2, test_bits2, sizeof(test_bits2),
+             test_serialized, sizeof(test_serialized)) != -1)
+        ok = 0;
+
+    /* Invalid parameters to the initialization function */
+    if (ascon_bloom_init(&filter2, test_bits2, 63, TEST_K) != -1)
+        ok = 0;
+    if (ascon_bloom_init(&filter2, test_bits2, sizeof(test_bits2), 0) != -1)
+        ok = 0;
+
+    ascon_bloom_free(&filter);
+    report(ok);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t index;
+
+    (void)argc;
+    (void)argv;
+
+    for (index = 0; index < TEST_NUM_KEYS * 2; ++index) {
+        memcpy(test_keys[index], "key-", 4);
+        test_keys[index][4] = (unsigned char)(index >> 24);
+        test_keys[index][5] = (unsigned char)(index >> 16);
+        test_keys[index][6] = (unsigned char)(index >> 8);
+        test_keys[index][7] = (unsigned char)index;
+        test_key_ptrs[index] = test_keys[index];
+        test_key_lens[index] = 8;
+    }
+
+    test_multi_index();
+    test_bloom_insert_query();
+    test_bloom_serialize();
+
+    return test_exit_result;
+}
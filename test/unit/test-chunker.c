@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2023 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <ascon/chunker.h>
+#include <ascon/hash.h>
+#include <ascon/xof.h>
+#include "test-cipher.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#define TEST_DATA_SIZE  (256 * 1024)
+#define TEST_MIN_SIZE   1024
+#define TEST_AVG_SIZE   4096
+#define TEST_MAX_SIZE   16384
+#define MAX_CHUNKS      (TEST_DATA_SIZE / TEST_MIN_SIZE + 1)
+
+static unsigned char test_data[TEST_DATA_SIZE];
+static ascon_chunk_t chunks1[MAX_CHUNKS];
+static ascon_chunk_t chunks2[MAX_CHUNKS];
+
+/* Chunk the test data by feeding it in pieces of a specific size */
+static size_t chunk_data(ascon_chunk_t *chunks, int hasha, size_t piece)
+{
+    ascon_chunker_state_t state;
+    const unsigned char *in;
+    size_t inlen;
+    size_t posn = 0;
+    size_t count = 0;
+    if (hasha) {
+        ascon_chunker_init_hasha
+            (&state, TEST_MIN_SIZE, TEST_AVG_SIZE, TEST_MAX_SIZE);
+    } else {
+        ascon_chunker_init
+            (&state, TEST_MIN_SIZE, TEST_AVG_SIZE, TEST_MAX_SIZE);
+    }
+    while (posn < TEST_DATA_SIZE) {
+        in = test_data + posn;
+        inlen = TEST_DATA_SIZE - posn;
+        if (inlen > piece)
+            inlen = piece;
+        posn += inlen;
+        while (count < MAX_CHUNKS &&
+               ascon_chunker_update(&state, &in, &inlen, &chunks[count]))
+            ++count;
+    }
+    if (count < MAX_CHUNKS && ascon_chunker_finalize(&state, &chunks[count]))
+        ++count;
+    ascon_chunker_free(&state);
+    return count;
+}
+
+static int test_chunker_alg(const char *name, int hasha)
+{
+    static size_t const pieces[] = {1, 7, 1000, 4096, 65537};
+    unsigned char digest[ASCON_HASH_SIZE];
+    size_t count1, count2, index, piece;
+    uint64_t offset = 0;
+    int ok = 1;
+
+    printf("%s chunker ... ", name);
+    fflush(stdout);
+
+    /* Chunk the data in one request */
+    count1 = chunk_data(chunks1, hasha, TEST_DATA_SIZE);
+    if (count1 < 2 || count1 >= MAX_CHUNKS)
+        ok = 0;
+
+    /* Check that the chunks cover the data and obey the size limits */
+    for (index = 0; ok && index < count1; ++index) {
+        const ascon_chunk_t *chunk = &(chunks1[index]);
+        if (chunk->offset != offset || chunk->length > TEST_MAX_SIZE) {
+            ok = 0;
+            break;
+        }
+        if (chunk->length < TEST_MIN_SIZE && index != (count1 - 1)) {
+            ok = 0;
+            break;
+        }
+        if (hasha)
+            ascon_hasha(digest, test_data + offset, chunk->length);
+        else
+            ascon_hash(digest, test_data + offset, chunk->length);
+        if (test_memcmp(chunk->digest, digest, sizeof(digest)) != 0) {
+            ok = 0;
+            break;
+        }
+        offset += chunk->length;
+    }
+    if (offset != TEST_DATA_SIZE)
+        ok = 0;
+
+    /* The boundaries must not depend upon how the data is split up */
+    for (piece = 0; ok && piece < sizeof(pieces) / sizeof(pieces[0]); ++piece) {
+        count2 = chunk_data(chunks2, hasha, pieces[piece]);
+        if (count2 != count1)
+            ok = 0;
+        for (index = 0; ok && index < count1; ++index) {
+            if (chunks1[index].offset != chunks2[index].offset ||
+                    chunks1[index].length != chunks2[index].length ||
+                    memcmp(chunks1[index].digest, chunks2[index].digest,
+                           ASCON_HASH_SIZE) != 0)
+                ok = 0;
+        }
+    }
+
+    if (ok)
+        printf("ok\n");
+    else
+        printf("failed\n");
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    ascon_xof_state_t xof;
+
+    (void)argc;
+    (void)argv;
+
+    if (!hash_sanity_check())
+        return 1;
+
+    /* Generate pseudorandom test data */
+    ascon_xof_init(&xof);
+    ascon_xof_absorb(&xof, (const unsigned char *)"chunker", 7);
+    ascon_xof_squeeze(&xof, test_data, sizeof(test_data));
+    ascon_xof_free(&xof);
+
+    if (!test_chunker_alg("ASCON-HASH", 0))
+        test_exit_result = 1;
+    if (!test_chunker_alg("ASCON-HASHA", 1))
+        test_exit_result = 1;
+
+    return test_exit_result;
+}
@@ -123,6 +123,7 @@ static int test_cxof_inner
     size_t custlen = custom ? strlen(custom) : 0;
     ascon_xof_state_t state1;
     ascon_xof_state_t state2;
+    ascon_xof_precomputed_t pre;
     unsigned char out1[ASCON_HASH_SIZE];
     unsigned char out2[ASCON_HASH_SIZE];
     const unsigned char *in = (const unsigned char *)"Payload Data";
@@ -167,6 +168,25 @@ static int test_cxof_inner
     if (test_memcmp(out1, out2, sizeof(out1)) != 0) {
         return 0;
     }
+
+    /* Initialize from a pre-computed state and test again */
+    ascon_xof_precompute(&pre, function_name, cust, custlen, outlen);
+    ascon_xof_init_precomputed(&state1, &pre);
+    ascon_xof_absorb(&state1, in, inlen);
+    ascon_xof_squeeze(&state1, out1, sizeof(out1));
+    if (test_memcmp(out1, out2, sizeof(out1)) != 0) {
+        ascon_xof_free(&state1);
+        ascon_xof_precomputed_free(&pre);
+        return 0;
+    }
+    ascon_xof_reinit_precomputed(&state1, &pre);
+    ascon_xof_absorb(&state1, in, inlen);
+    ascon_xof_squeeze(&state1, out1, sizeof(out1));
+    ascon_xof_free(&state1);
+    ascon_xof_precomputed_free(&pre);
+    if (test_memcmp(out1, out2, sizeof(out1)) != 0) {
+        return 0;
+    }
     return 1;
 }
 
@@ -177,6 +197,7 @@ static int test_cxofa_inner
     size_t custlen = custom ? strlen(custom) : 0;
     ascon_xofa_state_t state1;
     ascon_xofa_state_t state2;
+    ascon_xofa_precomputed_t pre;
     unsigned char out1[ASCON_HASH_SIZE];
     unsigned char out2[ASCON_HASH_SIZE];
     const unsigned char *in = (const unsigned char *)"Payload Data";
@@ -221,6 +242,25 @@ static int test_cxofa_inner
     if (test_memcmp(out1, out2, sizeof(out1)) != 0) {
         return 0;
     }
+
+    /* Initialize from a pre-computed state and test again */
+    ascon_xofa_precompute(&pre, function_name, cust, custlen, outlen);
+    ascon_xofa_init_precomputed(&state1, &pre);
+    ascon_xofa_absorb(&state1, in, inlen);
+    ascon_xofa_squeeze(&state1, out1, sizeof(out1));
+    if (test_memcmp(out1, out2, sizeof(out1)) != 0) {
+        ascon_xofa_free(&state1);
+        ascon_xofa_precomputed_free(&pre);
+        return 0;
+    }
+    ascon_xofa_reinit_precomputed(&state1, &pre);
+    ascon_xofa_absorb(&state1, in, inlen);
+    ascon_xofa_squeeze(&state1, out1, sizeof(out1));
+    ascon_xofa_free(&state1);
+    ascon_xofa_precomputed_free(&pre);
+    if (test_memcmp(out1, out2, sizeof(out1)) != 0) {
+        return 0;
+    }
     return 1;
 }
 
@@ -260,6 +300,58 @@ static int test_cxofa(void)
     return ok;
 }
 
+/* Squeezing whole blocks in bulk must match byte-at-a-time squeezing */
+#define BULK_SQUEEZE_SIZE 1024
+static int test_xof_bulk_squeeze(void)
+{
+    static unsigned char out1[BULK_SQUEEZE_SIZE];
+    static unsigned char out2[BULK_SQUEEZE_SIZE];
+    const unsigned char *in = (const unsigned char *)"Payload Data";
+    ascon_xof_state_t xof;
+    ascon_xofa_state_t xofa;
+    size_t posn;
+    int ok = 1;
+
+    printf("ASCON-XOF bulk squeeze ... ");
+    fflush(stdout);
+    ascon_xof_init(&xof);
+    ascon_xof_absorb(&xof, in, 12);
+    ascon_xof_squeeze(&xof, out1, ASCON_XOF_RATE);
+    ascon_xof_squeeze(&xof, out1 + ASCON_XOF_RATE,
+                      BULK_SQUEEZE_SIZE - ASCON_XOF_RATE);
+    ascon_xof_reinit(&xof);
+    ascon_xof_absorb(&xof, in, 12);
+    for (posn = 0; posn < BULK_SQUEEZE_SIZE; ++posn)
+        ascon_xof_squeeze(&xof, out2 + posn, 1);
+    ascon_xof_free(&xof);
+    if (test_memcmp(out1, out2, BULK_SQUEEZE_SIZE) != 0) {
+        printf("failed\n");
+        ok = 0;
+    } else {
+        printf("ok\n");
+    }
+
+    printf("ASCON-XOFA bulk squeeze ... ");
+    fflush(stdout);
+    ascon_xofa_init(&xofa);
+    ascon_xofa_absorb(&xofa, in, 12);
+    ascon_xofa_squeeze(&xofa, out1, ASCON_XOF_RATE);
+    ascon_xofa_squeeze(&xofa, out1 + ASCON_XOF_RATE,
+                       BULK_SQUEEZE_SIZE - ASCON_XOF_RATE);
+    ascon_xofa_reinit(&xofa);
+    ascon_xofa_absorb(&xofa, in, 12);
+    for (posn = 0; posn < BULK_SQUEEZE_SIZE; ++posn)
+        ascon_xofa_squeeze(&xofa, out2 + posn, 1);
+    ascon_xofa_free(&xofa);
+    if (test_memcmp(out1, out2, BULK_SQUEEZE_SIZE) != 0) {
+        printf("failed\n");
+        ok = 0;
+    } else {
+        printf("ok\n");
+    }
+    return ok;
+}
+
 int main(int argc, char *argv[])
 {
     (void)argc;
@@ -272,6 +364,8 @@ int main(int argc, char *argv[])
         test_exit_result = 1;
     if (!test_cxofa())
         test_exit_result = 1;
+    if (!test_xof_bulk_squeeze())
+        test_exit_result = 1;
 
     return test_exit_result;
 }
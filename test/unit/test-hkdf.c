@@ -322,6 +322,91 @@ static void test_hkdf_vector
     }
 }
 
+typedef void (*hkdf_context_init_t)
+    (void *context, const unsigned char *key, size_t keylen,
+     const unsigned char *salt, size_t saltlen);
+typedef void (*hkdf_context_free_t)(void *context);
+typedef int (*hkdf_context_expand_t)
+    (const void *context, const unsigned char *info, size_t infolen,
+     unsigned char *out, size_t outlen);
+typedef int (*hkdf_context_expand_labels_t)
+    (const void *context, const ascon_hkdf_label_t *labels, size_t count);
+
+#define NUM_LABELS 7
+
+static void test_hkdf_context
+    (const char *name, const TestHKDFVector *test_vector,
+     hkdf_all_in_one_t all_in_one, hkdf_context_init_t init,
+     hkdf_context_free_t free, hkdf_context_expand_t expand,
+     hkdf_context_expand_labels_t expand_labels, size_t context_size)
+{
+    /* Mix of labels that can and cannot be expanded side by side */
+    static char const * const infos[NUM_LABELS] = {
+        "client key", "server key", "client iv", "server iv",
+        "exporter", "resumption master secret with a long label "
+            "that is too long to expand side by side", "x"
+    };
+    static size_t const outlens[NUM_LABELS] = {32, 16, 12, 80, 82, 40, 0};
+    unsigned char context[context_size];
+    unsigned char actual[NUM_LABELS][MAX_OUT_LEN];
+    unsigned char expected[NUM_LABELS][MAX_OUT_LEN];
+    ascon_hkdf_label_t labels[NUM_LABELS];
+    size_t index;
+    int ok = 1;
+
+    printf("%s Context %s ... ", name, test_vector->name);
+    fflush(stdout);
+
+    /* Generate the expected output with the all-in-one function */
+    memset(actual, 0xAA, sizeof(actual));
+    memset(expected, 0xAA, sizeof(expected));
+    for (index = 0; index < NUM_LABELS; ++index) {
+        (*all_in_one)
+            (expected[index], outlens[index],
+             test_vector->key, test_vector->key_len,
+             test_vector->salt, test_vector->salt_len,
+             (const unsigned char *)(infos[index]), strlen(infos[index]));
+        labels[index].info = (const unsigned char *)(infos[index]);
+        labels[index].infolen = strlen(infos[index]);
+        labels[index].out = actual[index];
+        labels[index].outlen = outlens[index];
+    }
+
+    /* Expand all of the labels in one call */
+    (*init)(context, test_vector->key, test_vector->key_len,
+            test_vector->salt, test_vector->salt_len);
+    if ((*expand_labels)(context, labels, NUM_LABELS) != 0)
+        ok = 0;
+    if (test_memcmp(actual[0], expected[0], sizeof(actual)) != 0)
+        ok = 0;
+
+    /* Expand the labels one at a time */
+    memset(actual, 0xAA, sizeof(actual));
+    for (index = 0; index < NUM_LABELS; ++index) {
+        if ((*expand)(context, labels[index].info, labels[index].infolen,
+                      actual[index], outlens[index]) != 0)
+            ok = 0;
+    }
+    if (test_memcmp(actual[0], expected[0], sizeof(actual)) != 0)
+        ok = 0;
+
+    /* Output that is too long should fail without generating anything */
+    memset(actual, 0xAA, sizeof(actual));
+    labels[2].outlen = ASCON_HKDF_OUTPUT_SIZE * 255 + 1;
+    if ((*expand_labels)(context, labels, NUM_LABELS) != -1)
+        ok = 0;
+    if (actual[0][0] != 0xAA || actual[1][0] != 0xAA)
+        ok = 0;
+    (*free)(context);
+
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
 int main(int argc, char *argv[])
 {
     (void)argc;
@@ -372,5 +457,39 @@ int main(int argc, char *argv[])
          (hkdf_expand_t)ascon_hkdfa_expand,
          ascon_hmaca, sizeof(ascon_hkdfa_state_t));
 
+    test_hkdf_context
+        ("ASCON-HKDF", &testVectorHKDF_1,
+         (hkdf_all_in_one_t)ascon_hkdf,
+         (hkdf_context_init_t)ascon_hkdf_context_init,
+         (hkdf_context_free_t)ascon_hkdf_context_free,
+         (hkdf_context_expand_t)ascon_hkdf_context_expand,
+         (hkdf_context_expand_labels_t)ascon_hkdf_context_expand_labels,
+         sizeof(ascon_hkdf_context_t));
+    test_hkdf_context
+        ("ASCON-HKDF", &testVectorHKDF_3,
+         (hkdf_all_in_one_t)ascon_hkdf,
+         (hkdf_context_init_t)ascon_hkdf_context_init,
+         (hkdf_context_free_t)ascon_hkdf_context_free,
+         (hkdf_context_expand_t)ascon_hkdf_context_expand,
+         (hkdf_context_expand_labels_t)ascon_hkdf_context_expand_labels,
+         sizeof(ascon_hkdf_context_t));
+
+    test_hkdf_context
+        ("ASCON-HKDFA", &testVectorHKDF_1,
+         (hkdf_all_in_one_t)ascon_hkdfa,
+         (hkdf_context_init_t)ascon_hkdfa_context_init,
+         (hkdf_context_free_t)ascon_hkdfa_context_free,
+         (hkdf_context_expand_t)ascon_hkdfa_context_expand,
+         (hkdf_context_expand_labels_t)ascon_hkdfa_context_expand_labels,
+         sizeof(ascon_hkdfa_context_t));
+    test_hkdf_context
+        ("ASCON-HKDFA", &testVectorHKDF_3,
+         (hkdf_all_in_one_t)ascon_hkdfa,
+         (hkdf_context_init_t)ascon_hkdfa_context_init,
+         (hkdf_context_free_t)ascon_hkdfa_context_free,
+         (hkdf_context_expand_t)ascon_hkdfa_context_expand,
+         (hkdf_context_expand_labels_t)ascon_hkdfa_context_expand_labels,
+         sizeof(ascon_hkdfa_context_t));
+
     return test_exit_result;
 }
@@ -142,6 +142,58 @@ static void hmac
     free(state);
 }
 
+/* Computes HMAC with a pre-computed key context, incrementally and then
+ * in a single call, checking that the key context can be reused. */
+static void ascon_hmac_precomputed
+    (unsigned char *out,
+     const unsigned char *key, size_t keylen,
+     const unsigned char *in, size_t inlen)
+{
+    ascon_hmac_key_t ctx;
+    ascon_hmac_state_t state;
+    unsigned char out2[ASCON_HMAC_SIZE];
+    ascon_hmac_key_init(&ctx, key, keylen);
+    ascon_hmac_init_precomputed(&state, &ctx);
+    ascon_hmac_update(&state, in, inlen / 2);
+    ascon_hmac_update(&state, in + inlen / 2, inlen - inlen / 2);
+    ascon_hmac_finalize_precomputed(&state, &ctx, out2);
+    ascon_hmac_reinit_precomputed(&state, &ctx);
+    ascon_hmac_update(&state, in, inlen);
+    ascon_hmac_finalize_precomputed(&state, &ctx, out);
+    ascon_hmac_free(&state);
+    if (memcmp(out, out2, ASCON_HMAC_SIZE) != 0)
+        memset(out, 0, ASCON_HMAC_SIZE);
+    ascon_hmac_with_key(out2, &ctx, in, inlen);
+    if (memcmp(out, out2, ASCON_HMAC_SIZE) != 0)
+        memset(out, 0, ASCON_HMAC_SIZE);
+    ascon_hmac_key_free(&ctx);
+}
+
+static void ascon_hmaca_precomputed
+    (unsigned char *out,
+     const unsigned char *key, size_t keylen,
+     const unsigned char *in, size_t inlen)
+{
+    ascon_hmaca_key_t ctx;
+    ascon_hmaca_state_t state;
+    unsigned char out2[ASCON_HMACA_SIZE];
+    ascon_hmaca_key_init(&ctx, key, keylen);
+    ascon_hmaca_init_precomputed(&state, &ctx);
+    ascon_hmaca_update(&state, in, inlen / 2);
+    ascon_hmaca_update(&state, in + inlen / 2, inlen - inlen / 2);
+    ascon_hmaca_finalize_precomputed(&state, &ctx, out2);
+    ascon_hmaca_reinit_precomputed(&state, &ctx);
+    ascon_hmaca_update(&state, in, inlen);
+    ascon_hmaca_finalize_precomputed(&state, &ctx, out);
+    ascon_hmaca_free(&state);
+    if (memcmp(out, out2, ASCON_HMACA_SIZE) != 0)
+        memset(out, 0, ASCON_HMACA_SIZE);
+    ascon_hmaca_with_key(out2, &ctx, in, inlen);
+    if (memcmp(out, out2, ASCON_HMACA_SIZE) != 0)
+        memset(out, 0, ASCON_HMACA_SIZE);
+    ascon_hmaca_key_free(&ctx);
+}
+
 static void test_hmac_vector
     (const HashFuncs *alg, const char *name,
      hmac_func_t func, const TestHMACVector *test_vector,
@@ -173,6 +225,82 @@ static void test_hmac_vector
     }
 }
 
+#define BATCH_SIZE 10
+
+typedef int (*hmac_verify_batch_t)
+    (unsigned char *results, const unsigned char *const *tag,
+     const unsigned char *const *in, const size_t *inlen,
+     const unsigned char *const *key, const size_t *keylen, size_t count);
+
+static void test_hmac_verify_batch
+    (const char *name, hmac_func_t func, hmac_verify_batch_t verify_batch,
+     unsigned hmac_size)
+{
+    static char const * const keys[] = {"Jefe", "key", "secret key"};
+    unsigned char data[BATCH_SIZE * 20];
+    unsigned char tags[BATCH_SIZE][hmac_size];
+    const unsigned char *tag[BATCH_SIZE];
+    const unsigned char *in[BATCH_SIZE];
+    const unsigned char *key[BATCH_SIZE];
+    size_t inlen[BATCH_SIZE];
+    size_t keylen[BATCH_SIZE];
+    unsigned char results[(BATCH_SIZE + 7) / 8];
+    unsigned expected = 0;
+    unsigned actual;
+    size_t index;
+    int ok = 1;
+
+    printf("    %s Verify Batch ... ", name);
+    fflush(stdout);
+
+    /* Items 0 to 3 share a key to exercise key context re-use */
+    for (index = 0; index < sizeof(data); ++index)
+        data[index] = (unsigned char)(index * 3 + 1);
+    for (index = 0; index < BATCH_SIZE; ++index) {
+        key[index] = (const unsigned char *)
+            (keys[index < 4 ? 0 : (index % 3)]);
+        keylen[index] = strlen((const char *)(key[index]));
+        in[index] = data + index * 7;
+        inlen[index] = index * 13;
+        (*func)(tags[index], key[index], keylen[index],
+                in[index], inlen[index]);
+        tag[index] = tags[index];
+        expected |= 1U << index;
+    }
+
+    /* Everything should verify */
+    memset(results, 0xAA, sizeof(results));
+    if ((*verify_batch)(results, tag, in, inlen, key, keylen,
+                        BATCH_SIZE) != 0)
+        ok = 0;
+    if ((unsigned)(results[0] | (results[1] << 8)) != expected)
+        ok = 0;
+
+    /* Corrupt some of the tags */
+    tags[2][0] ^= 0x01;
+    tags[5][hmac_size - 1] ^= 0x80;
+    tags[9][7] ^= 0x10;
+    expected &= ~((1U << 2) | (1U << 5) | (1U << 9));
+    memset(results, 0xAA, sizeof(results));
+    if ((*verify_batch)(results, tag, in, inlen, key, keylen,
+                        BATCH_SIZE) != -1)
+        ok = 0;
+    actual = results[0] | (results[1] << 8);
+    if (actual != expected)
+        ok = 0;
+
+    /* An empty batch is always valid */
+    if ((*verify_batch)(results, tag, in, inlen, key, keylen, 0) != 0)
+        ok = 0;
+
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
 int main(int argc, char *argv[])
 {
     (void)argc;
@@ -195,5 +323,30 @@ int main(int argc, char *argv[])
     test_hmac_vector
         (&alg_ascon_hasha, "ASCON-HMACA", ascon_hmaca, &testVectorHMAC_3, 32, 64);
 
+    test_hmac_vector
+        (&alg_ascon_hash, "ASCON-HMAC-precomputed", ascon_hmac_precomputed,
+         &testVectorHMAC_1, 32, 64);
+    test_hmac_vector
+        (&alg_ascon_hash, "ASCON-HMAC-precomputed", ascon_hmac_precomputed,
+         &testVectorHMAC_2, 32, 64);
+    test_hmac_vector
+        (&alg_ascon_hash, "ASCON-HMAC-precomputed", ascon_hmac_precomputed,
+         &testVectorHMAC_3, 32, 64);
+
+    test_hmac_vector
+        (&alg_ascon_hasha, "ASCON-HMACA-precomputed", ascon_hmaca_precomputed,
+         &testVectorHMAC_1, 32, 64);
+    test_hmac_vector
+        (&alg_ascon_hasha, "ASCON-HMACA-precomputed", ascon_hmaca_precomputed,
+         &testVectorHMAC_2, 32, 64);
+    test_hmac_vector
+        (&alg_ascon_hasha, "ASCON-HMACA-precomputed", ascon_hmaca_precomputed,
+         &testVectorHMAC_3, 32, 64);
+
+    test_hmac_verify_batch
+        ("ASCON-HMAC", ascon_hmac, ascon_hmac_verify_batch, 32);
+    test_hmac_verify_batch
+        ("ASCON-HMACA", ascon_hmaca, ascon_hmaca_verify_batch, 32);
+
     return test_exit_result;
 }
@@ -0,0 +1,341 @@
+/*
+ * Copyright (C) 2023 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <ascon/kdf-tree.h>
+#include "test-cipher.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_NUM_ENTRIES 4
+#define TEST_MAX_DEPTH 3
+
+static unsigned char const test_root[ASCON_KDF_TREE_KEY_SIZE] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F
+};
+
+static const char *const test_tenants[] = {
+    "alice", "bob", "carol", "dave", "eve", "frank"
+};
+#define TEST_NUM_TENANTS (sizeof(test_tenants) / sizeof(test_tenants[0]))
+
+static const char *const test_purposes[] = {"storage", "session"};
+
+/* Derives a key by chaining ascon_kdf() calls from the root */
+static void test_kdf_chain
+    (unsigned char *key, const unsigned char *const *labels,
+     const size_t *labellens, size_t depth)
+{
+    unsigned char parent[ASCON_KDF_TREE_KEY_SIZE];
+    size_t level;
+    memcpy(parent, test_root, sizeof(parent));
+    for (level = 0; level < depth; ++level) {
+        ascon_kdf(key, ASCON_KDF_TREE_KEY_SIZE, parent, sizeof(parent),
+                  labels[level], labellens[level]);
+        memcpy(parent, key, sizeof(parent));
+    }
+}
+
+/* Derives the key for a tenant and purpose through the tree and checks
+ * it against the chained ascon_kdf() calls */
+static int test_kdf_tree_check
+    (ascon_kdf_tree_t *tree, const char *tenant, const char *purpose,
+     size_t depth)
+{
+    const unsigned char *labels[TEST_MAX_DEPTH];
+    size_t labellens[TEST_MAX_DEPTH];
+    unsigned char expected[ASCON_KDF_TREE_KEY_SIZE];
+    unsigned char actual[ASCON_KDF_TREE_KEY_SIZE];
+
+    labels[0] = (const unsigned char *)tenant;
+    labellens[0] = strlen(tenant);
+    labels[1] = (const unsigned char *)purpose;
+    labellens[1] = strlen(purpose);
+    labels[2] = (const unsigned char *)"epoch-1";
+    labellens[2] = 7;
+    test_kdf_chain(expected, labels, labellens, depth);
+    memset(actual, 0xAA, sizeof(actual));
+    if (ascon_kdf_tree_derive(tree, actual, labels, labellens, depth) != 0)
+        return 0;
+    return test_memcmp(actual, expected, sizeof(actual)) == 0;
+}
+
+/* Returns the number of occupied entries in the cache */
+static size_t test_kdf_tree_count(const ascon_kdf_tree_t *tree)
+{
+    size_t index;
+    size_t count = 0;
+    for (index = 0; index < tree->num_entries; ++index) {
+        if (tree->entries[index].pathlen != 0)
+            ++count;
+    }
+    return count;
+}
+
+static void test_kdf_tree_derive(size_t num_entries)
+{
+    ascon_kdf_tree_entry_t entries[TEST_NUM_ENTRIES];
+    ascon_kdf_tree_t tree;
+    size_t tenant, purpose, depth, round;
+    int ok = 1;
+
+    printf("ASCON-KDF Tree Derive (%u entries) ... ", (unsigned)num_entries);
+    fflush(stdout);
+
+    if (ascon_kdf_tree_init
+            (&tree, test_root, sizeof(test_root), entries, num_entries) != 0)
+        ok = 0;
+
+    /* Derive more keys than will fit in the cache, several times over,
+     * so that we exercise hits, partial hits, and evictions */
+    for (round = 0; round < 3; ++round) {
+        for (tenant = 0; tenant < TEST_NUM_TENANTS; ++tenant) {
+            for (purpose = 0; purpose < 2; ++purpose) {
+                for (depth = 1; depth <= TEST_MAX_DEPTH; ++depth) {
+                    if (!test_kdf_tree_check
+                            (&tree, test_tenants[tenant],
+                             test_purposes[purpose], depth)) {
+                        ok = 0;
+                    }
+                }
+            }
+            /* Keep going back to the first tenant so that it stays hot */
+            if (!test_kdf_tree_check(&tree, test_tenants[0], "storage", 2))
+                ok = 0;
+        }
+    }
+    if (test_kdf_tree_count(&tree) != num_entries)
+        ok = 0;
+
+    /* The hot tenant should have survived all of the evictions */
+    if (num_entries > 0) {
+        size_t index;
+        int found = 0;
+        for (index = 0; index < num_entries; ++index) {
+            if (entries[index].pathlen == 6 + 8 &&
+                    memcmp(entries[index].path, "\005alice\007storage",
+                           6 + 8) == 0) {
+                found = 1;
+            }
+        }
+        if (!found)
+            ok = 0;
+
+        /* Reused entries must not contain leftovers of longer paths */
+        for (index = 0; index < num_entries; ++index) {
+            size_t posn;
+            for (posn = entries[index].pathlen;
+                    posn < ASCON_KDF_TREE_MAX_PATH; ++posn) {
+                if (entries[index].path[posn] != 0)
+                    ok = 0;
+            }
+        }
+    }
+
+    ascon_kdf_tree_free(&tree);
+    if (test_kdf_tree_count(&tree) != 0)
+        ok = 0;
+
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
+/* Determines if a single-level path for a tenant is in the cache */
+static int test_kdf_tree_has(const ascon_kdf_tree_t *tree, const char *tenant)
+{
+    size_t len = strlen(tenant);
+    size_t index;
+    for (index = 0; index < tree->num_entries; ++index) {
+        const ascon_kdf_tree_entry_t *entry = &(tree->entries[index]);
+        if (entry->pathlen == len + 1 && entry->path[0] == len &&
+                memcmp(entry->path + 1, tenant, len) == 0)
+            return 1;
+    }
+    return 0;
+}
+
+static void test_kdf_tree_lru(void)
+{
+    ascon_kdf_tree_entry_t entries[2];
+    ascon_kdf_tree_t tree;
+    int ok = 1;
+
+    printf("ASCON-KDF Tree LRU ... ");
+    fflush(stdout);
+
+    /* All paths have the same length, so a hit must only refresh the
+     * entry that matched and not every entry of the same length */
+    ascon_kdf_tree_init(&tree, test_root, sizeof(test_root), entries, 2);
+    if (!test_kdf_tree_check(&tree, "alice", "storage", 1) ||
+            !test_kdf_tree_check(&tree, "carol", "storage", 1) ||
+            !test_kdf_tree_check(&tree, "alice", "storage", 1) ||
+            !test_kdf_tree_check(&tree, "frank", "storage", 1))
+        ok = 0;
+    if (!test_kdf_tree_has(&tree, "alice") ||
+            test_kdf_tree_has(&tree, "carol") ||
+            !test_kdf_tree_has(&tree, "frank"))
+        ok = 0;
+
+    /* Touch the other entry and check that the order follows */
+    if (!test_kdf_tree_check(&tree, "frank", "storage", 1) ||
+            !test_kdf_tree_check(&tree, "carol", "storage", 1))
+        ok = 0;
+    if (test_kdf_tree_has(&tree, "alice") ||
+            !test_kdf_tree_has(&tree, "carol") ||
+            !test_kdf_tree_has(&tree, "frank"))
+        ok = 0;
+    ascon_kdf_tree_free(&tree);
+
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
+static void test_kdf_tree_forget(void)
+{
+    ascon_kdf_tree_entry_t entries[TEST_NUM_ENTRIES];
+    ascon_kdf_tree_t tree;
+    const unsigned char *labels[1];
+    size_t labellens[1];
+    size_t index;
+    int ok = 1;
+
+    printf("ASCON-KDF Tree Forget ... ");
+    fflush(stdout);
+
+    ascon_kdf_tree_init
+        (&tree, test_root, sizeof(test_root), entries, TEST_NUM_ENTRIES);
+    if (!test_kdf_tree_check(&tree, "alice", "storage", 2))
+        ok = 0;
+    if (!test_kdf_tree_check(&tree, "bob", "storage", 2))
+        ok = 0;
+    if (test_kdf_tree_count(&tree) != 4)
+        ok = 0;
+
+    /* Forget "alice" and everything below it */
+    labels[0] = (const unsigned char *)"alice";
+    labellens[0] = 5;
+    ascon_kdf_tree_forget(&tree, labels, labellens, 1);
+    if (test_kdf_tree_count(&tree) != 2)
+        ok = 0;
+    for (index = 0; index < TEST_NUM_ENTRIES; ++index) {
+        if (entries[index].pathlen != 0 && entries[index].path[1] != 'b')
+            ok = 0;
+    }
+
+    /* Keys for "alice" should be re-derived correctly */
+    if (!test_kdf_tree_check(&tree, "alice", "storage", 2))
+        ok = 0;
+
+    /* Forget everything */
+    ascon_kdf_tree_forget(&tree, 0, 0, 0);
+    if (test_kdf_tree_count(&tree) != 0)
+        ok = 0;
+    ascon_kdf_tree_free(&tree);
+
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
+static void test_kdf_tree_errors(void)
+{
+    static unsigned char const long_label[256] = {0};
+    ascon_kdf_tree_entry_t entries[TEST_NUM_ENTRIES];
+    ascon_kdf_tree_t tree;
+    const unsigned char *labels[2];
+    size_t labellens[2];
+    unsigned char key[ASCON_KDF_TREE_KEY_SIZE];
+    int ok = 1;
+
+    printf("ASCON-KDF Tree Errors ... ");
+    fflush(stdout);
+
+    /* Root key is too long */
+    if (ascon_kdf_tree_init
+            (&tree, long_label, ASCON_KDF_TREE_KEY_SIZE + 1,
+             entries, TEST_NUM_ENTRIES) != -1)
+        ok = 0;
+
+    ascon_kdf_tree_init
+        (&tree, test_root, sizeof(test_root), entries, TEST_NUM_ENTRIES);
+
+    /* Empty path */
+    if (ascon_kdf_tree_derive(&tree, key, labels, labellens, 0) != -1)
+        ok = 0;
+
+    /* Label is too long */
+    labels[0] = long_label;
+    labellens[0] = 256;
+    if (ascon_kdf_tree_derive(&tree, key, labels, labellens, 1) != -1)
+        ok = 0;
+
+    /* Encoded path is too long */
+    labellens[0] = ASCON_KDF_TREE_MAX_PATH / 2;
+    labels[1] = long_label;
+    labellens[1] = ASCON_KDF_TREE_MAX_PATH / 2;
+    if (ascon_kdf_tree_derive(&tree, key, labels, labellens, 2) != -1)
+        ok = 0;
+
+    /* Longest path that fits */
+    labellens[1] = ASCON_KDF_TREE_MAX_PATH / 2 - 2;
+    if (ascon_kdf_tree_derive(&tree, key, labels, labellens, 2) != 0)
+        ok = 0;
+    if (test_kdf_tree_count(&tree) != 2)
+        ok = 0;
+    ascon_kdf_tree_free(&tree);
+
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    test_kdf_tree_derive(0);
+    test_kdf_tree_derive(1);
+    test_kdf_tree_derive(TEST_NUM_ENTRIES);
+    test_kdf_tree_lru();
+    test_kdf_tree_forget();
+    test_kdf_tree_errors();
+
+    return test_exit_result;
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2023 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <ascon/keyed-hash.h>
+#include <ascon/prf.h>
+#include "test-cipher.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_MAX_INPUT 40
+
+static unsigned char const test_key[ASCON_KEYED_HASH_KEY_SIZE] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F
+};
+
+static uint64_t load_be64(const unsigned char *in)
+{
+    uint64_t value = 0;
+    unsigned index;
+    for (index = 0; index < 8; ++index)
+        value = (value << 8) | in[index];
+    return value;
+}
+
+/* Checks the keyed hash against ASCON-PrfShort and ASCON-Prf */
+static void test_keyed_hash_prf(void)
+{
+    ascon_keyed_hash_key_t key;
+    unsigned char in[TEST_MAX_INPUT];
+    unsigned char out[8];
+    uint64_t expected;
+    size_t len;
+    int ok = 1;
+
+    printf("Keyed Hash vs ASCON-Prf ... ");
+    fflush(stdout);
+
+    for (len = 0; len < TEST_MAX_INPUT; ++len)
+        in[len] = (unsigned char)(len * 11 + 5);
+
+    ascon_keyed_hash_key_init(&key, test_key);
+    for (len = 0; len <= TEST_MAX_INPUT; ++len) {
+        if (len <= ASCON_PRF_SHORT_MAX_INPUT_SIZE)
+            ascon_prf_short(out, sizeof(out), in, len, test_key);
+        else
+            ascon_prf_fixed(out, sizeof(out), in, len, test_key);
+        expected = load_be64(out);
+        if (ascon_keyed_hash64(&key, in, len) != expected) {
+            printf("length %d ", (int)len);
+            ok = 0;
+        }
+    }
+    ascon_keyed_hash_key_free(&key);
+
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
+/* Checks that the word-oriented entry points match the byte-oriented one */
+static void test_keyed_hash_words(void)
+{
+    ascon_keyed_hash_key_t key;
+    unsigned char in[16];
+    uint64_t high = 0x0123456789ABCDEFULL;
+    uint64_t low = 0xFEDCBA9876543210ULL;
+    unsigned index;
+    int ok = 1;
+
+    printf("Keyed Hash Words ... ");
+    fflush(stdout);
+
+    ascon_keyed_hash_key_init(&key, test_key);
+    for (index = 0; index < 8; ++index) {
+        in[index] = (unsigned char)(high >> (56 - index * 8));
+        in[index + 8] = (unsigned char)(low >> (56 - index * 8));
+    }
+    if (ascon_keyed_hash64_u64(&key, high) !=
+            ascon_keyed_hash64(&key, in, 8))
+        ok = 0;
+    if (ascon_keyed_hash64_u128(&key, high, low) !=
+            ascon_keyed_hash64(&key, in, 16))
+        ok = 0;
+    if (ascon_keyed_hash64_u64(&key, high) ==
+            ascon_keyed_hash64_u64(&key, low))
+        ok = 0;
+    ascon_keyed_hash_key_free(&key);
+
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    test_keyed_hash_prf();
+    test_keyed_hash_words();
+
+    return test_exit_result;
+}
@@ -155,16 +155,36 @@ typedef void (*kmac_absorb_t)
     (void *state, const unsigned char *in, size_t inlen);
 typedef void (*kmac_squeeze_t)
     (void *state, unsigned char *out, size_t outlen);
+typedef void (*kmac_precompute_t)
+    (void *pre, const unsigned char *custom, size_t customlen, size_t outlen);
+typedef void (*kmac_init_precomputed_t)
+    (void *state, const void *pre, const unsigned char *key, size_t keylen);
+typedef void (*kmac_precomputed_free_t)(void *pre);
+typedef void (*kmac_key_init_t)
+    (void *key, const unsigned char *k, size_t keylen,
+     const unsigned char *custom, size_t customlen, size_t outlen);
+typedef void (*kmac_key_free_t)(void *key);
+typedef void (*kmac_init_keyed_t)(void *state, const void *key);
+typedef void (*kmac_with_key_t)
+    (const void *key, const unsigned char *in, size_t inlen,
+     unsigned char *out, size_t outlen);
 
 static void test_kmac_alg
     (const char *name, const aead_hash_algorithm_t *alg, unsigned state_size,
      kmac_allinone_t allinone, kmac_init_t init, kmac_free_t free,
      kmac_absorb_t absorb, kmac_squeeze_t squeeze,
-     const aead_mac_test_vector_t *test)
+     unsigned pre_size, kmac_precompute_t precompute,
+     kmac_init_precomputed_t init_precomputed,
+     kmac_precomputed_free_t pre_free,
+     unsigned key_size, kmac_key_init_t key_init, kmac_key_free_t key_free,
+     kmac_init_keyed_t init_keyed, kmac_init_keyed_t reinit_keyed,
+     kmac_with_key_t with_key, const aead_mac_test_vector_t *test)
 {
     unsigned char expected[AEAD_MAX_HASH_LEN];
     unsigned char out[AEAD_MAX_HASH_LEN];
     void *state;
+    void *pre;
+    void *key;
     int ok;
 
     printf("%s %s ... ", name, test->name);
@@ -198,6 +218,50 @@ static void test_kmac_alg
     (*free)(state);
     if (test_memcmp(out, expected, test->output_len) != 0)
         ok = 0;
+
+    /* Check the instantiation from a pre-computed customization state */
+    memset(out, 0xCC, sizeof(out));
+    pre = malloc(pre_size);
+    if (!pre)
+        exit(1);
+    (*precompute)(pre, (const unsigned char *)(test->salt),
+                  strlen(test->salt), test->output_len);
+    (*init_precomputed)(state, pre, test->key, test->key_len);
+    (*absorb)(state, test->input, test->input_len);
+    (*squeeze)(state, out, test->output_len);
+    (*free)(state);
+    (*pre_free)(pre);
+    if (test_memcmp(out, expected, test->output_len) != 0)
+        ok = 0;
+    free(pre);
+
+    /* Check the instantiation from a pre-computed key context, twice
+     * to make sure that the key context is not modified by its users */
+    key = malloc(key_size);
+    if (!key)
+        exit(1);
+    (*key_init)(key, test->key, test->key_len,
+                (const unsigned char *)(test->salt), strlen(test->salt),
+                test->output_len);
+    memset(out, 0xDD, sizeof(out));
+    (*init_keyed)(state, key);
+    (*absorb)(state, test->input, test->input_len);
+    (*squeeze)(state, out, test->output_len);
+    if (test_memcmp(out, expected, test->output_len) != 0)
+        ok = 0;
+    memset(out, 0xEE, sizeof(out));
+    (*reinit_keyed)(state, key);
+    (*absorb)(state, test->input, test->input_len);
+    (*squeeze)(state, out, test->output_len);
+    (*free)(state);
+    if (test_memcmp(out, expected, test->output_len) != 0)
+        ok = 0;
+    memset(out, 0xFF, sizeof(out));
+    (*with_key)(key, test->input, test->input_len, out, test->output_len);
+    if (test_memcmp(out, expected, test->output_len) != 0)
+        ok = 0;
+    (*key_free)(key);
+    free(key);
     free(state);
 
     /* Report the results */
@@ -224,6 +288,16 @@ int main(int argc, char *argv[])
                   (kmac_free_t)ascon_kmac_free,
                   (kmac_absorb_t)ascon_kmac_absorb,
                   (kmac_squeeze_t)ascon_kmac_squeeze,
+                  sizeof(ascon_xof_precomputed_t),
+                  (kmac_precompute_t)ascon_kmac_precompute,
+                  (kmac_init_precomputed_t)ascon_kmac_init_precomputed,
+                  (kmac_precomputed_free_t)ascon_xof_precomputed_free,
+                  sizeof(ascon_kmac_key_t),
+                  (kmac_key_init_t)ascon_kmac_key_init,
+                  (kmac_key_free_t)ascon_kmac_key_free,
+                  (kmac_init_keyed_t)ascon_kmac_init_keyed,
+                  (kmac_init_keyed_t)ascon_kmac_reinit_keyed,
+                  (kmac_with_key_t)ascon_kmac_with_key,
                   &testVectorNIST_1);
     test_kmac_alg("ASCON KMAC", &ascon_xof_algorithm,
                   sizeof(ascon_kmac_state_t),
@@ -232,6 +306,16 @@ int main(int argc, char *argv[])
                   (kmac_free_t)ascon_kmac_free,
                   (kmac_absorb_t)ascon_kmac_absorb,
                   (kmac_squeeze_t)ascon_kmac_squeeze,
+                  sizeof(ascon_xof_precomputed_t),
+                  (kmac_precompute_t)ascon_kmac_precompute,
+                  (kmac_init_precomputed_t)ascon_kmac_init_precomputed,
+                  (kmac_precomputed_free_t)ascon_xof_precomputed_free,
+                  sizeof(ascon_kmac_key_t),
+                  (kmac_key_init_t)ascon_kmac_key_init,
+                  (kmac_key_free_t)ascon_kmac_key_free,
+                  (kmac_init_keyed_t)ascon_kmac_init_keyed,
+                  (kmac_init_keyed_t)ascon_kmac_reinit_keyed,
+                  (kmac_with_key_t)ascon_kmac_with_key,
                   &testVectorNIST_2);
 
     test_kmac_alg("ASCON-A KMAC", &ascon_xofa_algorithm,
@@ -241,6 +325,16 @@ int main(int argc, char *argv[])
                   (kmac_free_t)ascon_kmaca_free,
                   (kmac_absorb_t)ascon_kmaca_absorb,
                   (kmac_squeeze_t)ascon_kmaca_squeeze,
+                  sizeof(ascon_xofa_precomputed_t),
+                  (kmac_precompute_t)ascon_kmaca_precompute,
+                  (kmac_init_precomputed_t)ascon_kmaca_init_precomputed,
+                  (kmac_precomputed_free_t)ascon_xofa_precomputed_free,
+                  sizeof(ascon_kmaca_key_t),
+                  (kmac_key_init_t)ascon_kmaca_key_init,
+                  (kmac_key_free_t)ascon_kmaca_key_free,
+                  (kmac_init_keyed_t)ascon_kmaca_init_keyed,
+                  (kmac_init_keyed_t)ascon_kmaca_reinit_keyed,
+                  (kmac_with_key_t)ascon_kmaca_with_key,
                   &testVectorNIST_1);
     test_kmac_alg("ASCON-A KMAC", &ascon_xofa_algorithm,
                   sizeof(ascon_kmac_state_t),
@@ -249,6 +343,16 @@ int main(int argc, char *argv[])
                   (kmac_free_t)ascon_kmaca_free,
                   (kmac_absorb_t)ascon_kmaca_absorb,
                   (kmac_squeeze_t)ascon_kmaca_squeeze,
+                  sizeof(ascon_xofa_precomputed_t),
+                  (kmac_precompute_t)ascon_kmaca_precompute,
+                  (kmac_init_precomputed_t)ascon_kmaca_init_precomputed,
+                  (kmac_precomputed_free_t)ascon_xofa_precomputed_free,
+                  sizeof(ascon_kmaca_key_t),
+                  (kmac_key_init_t)ascon_kmaca_key_init,
+                  (kmac_key_free_t)ascon_kmaca_key_free,
+                  (kmac_init_keyed_t)ascon_kmaca_init_keyed,
+                  (kmac_init_keyed_t)ascon_kmaca_reinit_keyed,
+                  (kmac_with_key_t)ascon_kmaca_with_key,
                   &testVectorNIST_2);
 
     return test_exit_result;
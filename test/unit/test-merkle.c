@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2023 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <ascon/merkle.h>
+#include <ascon/hash.h>
+#include "test-cipher.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#define TEST_CAPACITY 16
+#define TEST_DEPTH 4
+
+static unsigned char nodes1[ASCON_MERKLE_NODES_SIZE(TEST_CAPACITY)];
+static unsigned char nodes2[ASCON_MERKLE_NODES_SIZE(TEST_CAPACITY)];
+static unsigned char leaf_data[TEST_CAPACITY][8];
+static unsigned char leaf_hash[TEST_CAPACITY][ASCON_HASH_SIZE];
+
+/* Simple hash of a prefix byte and some data */
+static void simple_hash
+    (int hasha, unsigned char *out, unsigned char prefix,
+     const unsigned char *data, size_t len)
+{
+    unsigned char buf[1 + ASCON_HASH_SIZE * 2];
+    buf[0] = prefix;
+    memcpy(buf + 1, data, len);
+    if (hasha)
+        ascon_hasha(out, buf, len + 1);
+    else
+        ascon_hash(out, buf, len + 1);
+}
+
+/* Simple recursive computation of a Merkle root for cross-checking */
+static void simple_root
+    (int hasha, unsigned char *out, size_t first, size_t count)
+{
+    unsigned char pair[ASCON_HASH_SIZE * 2];
+    if (count == 1) {
+        memcpy(out, leaf_hash[first], ASCON_HASH_SIZE);
+        return;
+    }
+    simple_root(hasha, pair, first, count / 2);
+    simple_root(hasha, pair + ASCON_HASH_SIZE, first + count / 2, count / 2);
+    simple_hash(hasha, out, 0x01, pair, sizeof(pair));
+}
+
+static int test_merkle_alg(const char *name, int hasha)
+{
+    static size_t const batch[] = {1, 2, 3, 8, 9, 15};
+    ascon_merkle_tree_t tree1;
+    ascon_merkle_tree_t tree2;
+    const unsigned char *data[TEST_CAPACITY];
+    size_t lens[TEST_CAPACITY];
+    size_t bad_order[2] = {3, 2};
+    unsigned char root[ASCON_HASH_SIZE];
+    unsigned char proof[TEST_DEPTH * ASCON_HASH_SIZE];
+    size_t index, posn;
+    int ok = 1;
+
+    printf("%s Merkle tree ... ", name);
+    fflush(stdout);
+
+    /* Initialize the trees and the data for the leaves */
+    if (hasha) {
+        if (ascon_merkle_init_hasha(&tree1, nodes1, TEST_CAPACITY) != 0 ||
+                ascon_merkle_init_hasha(&tree2, nodes2, TEST_CAPACITY) != 0)
+            ok = 0;
+    } else {
+        if (ascon_merkle_init(&tree1, nodes1, TEST_CAPACITY) != 0 ||
+                ascon_merkle_init(&tree2, nodes2, TEST_CAPACITY) != 0)
+            ok = 0;
+    }
+    if (tree1.depth != TEST_DEPTH)
+        ok = 0;
+    for (index = 0; index < TEST_CAPACITY; ++index) {
+        memset(leaf_data[index], (int)index, sizeof(leaf_data[index]));
+        memset(leaf_hash[index], 0, ASCON_HASH_SIZE);
+    }
+
+    /* Check the root of the empty tree */
+    simple_root(hasha, root, 0, TEST_CAPACITY);
+    if (test_memcmp(ascon_merkle_root(&tree1), root, sizeof(root)) != 0)
+        ok = 0;
+
+    /* Set the leaves one at a time in the first tree */
+    for (index = 0; index < sizeof(batch) / sizeof(batch[0]); ++index) {
+        size_t leaf = batch[index];
+        if (ascon_merkle_set_leaf(&tree1, leaf, leaf_data[leaf], 8) != 0)
+            ok = 0;
+        simple_hash(hasha, leaf_hash[leaf], 0x00, leaf_data[leaf], 8);
+        data[index] = leaf_data[leaf];
+        lens[index] = 8;
+    }
+    simple_root(hasha, root, 0, TEST_CAPACITY);
+    if (test_memcmp(ascon_merkle_root(&tree1), root, sizeof(root)) != 0)
+        ok = 0;
+
+    /* Set the leaves as a batch in the second tree */
+    if (ascon_merkle_set_leaves
+            (&tree2, batch, data, lens, sizeof(batch) / sizeof(batch[0])) != 0)
+        ok = 0;
+    if (memcmp(nodes1, nodes2, sizeof(nodes1)) != 0)
+        ok = 0;
+
+    /* Bad batches should be rejected without modifying the tree */
+    if (ascon_merkle_set_leaves(&tree2, bad_order, data, lens, 2) == 0)
+        ok = 0;
+    bad_order[1] = TEST_CAPACITY;
+    if (ascon_merkle_set_leaves(&tree2, bad_order, data, lens, 2) == 0)
+        ok = 0;
+    if (memcmp(nodes1, nodes2, sizeof(nodes1)) != 0)
+        ok = 0;
+
+    /* Generate and verify proofs for all leaves that were set */
+    for (posn = 0; posn < sizeof(batch) / sizeof(batch[0]); ++posn) {
+        size_t leaf = batch[posn];
+        const unsigned char *ldata = leaf_data[leaf];
+        size_t llen = 8;
+        int result;
+        if (ascon_merkle_get_proof(&tree1, leaf, proof) != 0)
+            ok = 0;
+        if (hasha) {
+            result = ascon_merkle_verify_hasha
+                (root, leaf, TEST_DEPTH, ldata, llen, proof);
+        } else {
+            result = ascon_merkle_verify
+                (root, leaf, TEST_DEPTH, ldata, llen, proof);
+        }
+        if (result != 0)
+            ok = 0;
+
+        /* Proof should fail for the wrong index or a modified proof */
+        if (hasha) {
+            result = ascon_merkle_verify_hasha
+                (root, leaf ^ 1, TEST_DEPTH, ldata, llen, proof);
+        } else {
+            result = ascon_merkle_verify
+                (root, leaf ^ 1, TEST_DEPTH, ldata, llen, proof);
+        }
+        if (result == 0)
+            ok = 0;
+        proof[TEST_DEPTH * ASCON_HASH_SIZE - 1] ^= 0x01;
+        if (hasha) {
+            result = ascon_merkle_verify_hasha
+                (root, leaf, TEST_DEPTH, ldata, llen, proof);
+        } else {
+            result = ascon_merkle_verify
+                (root, leaf, TEST_DEPTH, ldata, llen, proof);
+        }
+        if (result == 0)
+            ok = 0;
+    }
+    if (ascon_merkle_get_proof(&tree1, TEST_CAPACITY, proof) == 0)
+        ok = 0;
+
+    if (ok)
+        printf("ok\n");
+    else
+        printf("failed\n");
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    ascon_merkle_tree_t tree;
+
+    (void)argc;
+    (void)argv;
+
+    if (!hash_sanity_check())
+        return 1;
+
+    /* Capacities that are not a power of two should be rejected */
+    if (ascon_merkle_init(&tree, nodes1, 0) == 0 ||
+            ascon_merkle_init(&tree, nodes1, 12) == 0) {
+        printf("Merkle tree capacity check failed\n");
+        test_exit_result = 1;
+    }
+
+    if (!test_merkle_alg("ASCON-HASH", 0))
+        test_exit_result = 1;
+    if (!test_merkle_alg("ASCON-HASHA", 1))
+        test_exit_result = 1;
+
+    return test_exit_result;
+}
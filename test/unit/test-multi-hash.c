@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2023 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include <ascon/multi-hash.h>
+#include <ascon/hash.h>
+#include <ascon/xof.h>
+#include "test-cipher.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#define TEST_DATA_SIZE 3000
+#define TEST_XOF_SIZE 64
+
+static unsigned char test_data[TEST_DATA_SIZE];
+
+/* Hashes the test data with a multi-hash state, split into pieces,
+ * and checks the results against the individual algorithms */
+static int test_multi_hash_split(unsigned algorithms, size_t piece)
+{
+    ascon_multi_hash_state_t state;
+    unsigned char expected[TEST_XOF_SIZE];
+    unsigned char actual[TEST_XOF_SIZE];
+    size_t posn, len;
+    int ok = 1;
+
+    ascon_multi_hash_init(&state, algorithms);
+    for (posn = 0; posn < TEST_DATA_SIZE; posn += len) {
+        len = TEST_DATA_SIZE - posn;
+        if (len > piece)
+            len = piece;
+        ascon_multi_hash_update(&state, test_data + posn, len);
+    }
+    if (algorithms & ASCON_MULTI_HASH) {
+        ascon_hash(expected, test_data, TEST_DATA_SIZE);
+        ascon_multi_hash_finalize_hash(&state, actual);
+        if (test_memcmp(actual, expected, ASCON_HASH_SIZE) != 0)
+            ok = 0;
+    }
+    if (algorithms & ASCON_MULTI_HASHA) {
+        ascon_hasha(expected, test_data, TEST_DATA_SIZE);
+        ascon_multi_hash_finalize_hasha(&state, actual);
+        if (test_memcmp(actual, expected, ASCON_HASHA_SIZE) != 0)
+            ok = 0;
+    }
+    if (algorithms & ASCON_MULTI_XOF) {
+        ascon_xof_state_t xof;
+        ascon_xof_init(&xof);
+        ascon_xof_absorb(&xof, test_data, TEST_DATA_SIZE);
+        ascon_xof_squeeze(&xof, expected, TEST_XOF_SIZE);
+        ascon_xof_free(&xof);
+        ascon_multi_hash_squeeze_xof(&state, actual, TEST_XOF_SIZE);
+        if (test_memcmp(actual, expected, TEST_XOF_SIZE) != 0)
+            ok = 0;
+    }
+    if (algorithms & ASCON_MULTI_XOFA) {
+        ascon_xofa_state_t xofa;
+        ascon_xofa_init(&xofa);
+        ascon_xofa_absorb(&xofa, test_data, TEST_DATA_SIZE);
+        ascon_xofa_squeeze(&xofa, expected, TEST_XOF_SIZE);
+        ascon_xofa_free(&xofa);
+        ascon_multi_hash_squeeze_xofa(&state, actual, TEST_XOF_SIZE);
+        if (test_memcmp(actual, expected, TEST_XOF_SIZE) != 0)
+            ok = 0;
+    }
+    ascon_multi_hash_free(&state);
+    return ok;
+}
+
+static int test_multi_hash(const char *name, unsigned algorithms)
+{
+    static size_t const pieces[] = {1, 3, 8, 13, 64, 1501, TEST_DATA_SIZE};
+    size_t index;
+    int ok = 1;
+
+    printf("Multi-hash %s ... ", name);
+    fflush(stdout);
+    for (index = 0; index < sizeof(pieces) / sizeof(pieces[0]); ++index) {
+        if (!test_multi_hash_split(algorithms, pieces[index]))
+            ok = 0;
+    }
+    if (ok)
+        printf("ok\n");
+    else
+        printf("failed\n");
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t index;
+
+    (void)argc;
+    (void)argv;
+
+    if (!hash_sanity_check())
+        return 1;
+
+    for (index = 0; index < TEST_DATA_SIZE; ++index)
+        test_data[index] = (unsigned char)(index * 7 + 3);
+
+    if (!test_multi_hash("HASH", ASCON_MULTI_HASH))
+        test_exit_result = 1;
+    if (!test_multi_hash("HASH+HASHA", ASCON_MULTI_HASH | ASCON_MULTI_HASHA))
+        test_exit_result = 1;
+    if (!test_multi_hash("HASHA+XOF", ASCON_MULTI_HASHA | ASCON_MULTI_XOF))
+        test_exit_result = 1;
+    if (!test_multi_hash("all", ASCON_MULTI_HASH | ASCON_MULTI_HASHA |
+                                ASCON_MULTI_XOF | ASCON_MULTI_XOFA))
+        test_exit_result = 1;
+
+    return test_exit_result;
+}
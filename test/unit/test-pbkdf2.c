@@ -28,7 +28,7 @@
 #include <string.h>
 #include <stdlib.h>
 
-#define MAX_OUT_LEN 40
+#define MAX_OUT_LEN 96
 
 typedef struct
 {
@@ -71,6 +71,13 @@ static TestPBKDF2Vector const testVectorPBKDF2_4 = {
     4096,
     40
 };
+static TestPBKDF2Vector const testVectorPBKDF2_5 = {
+    "Test Vector 5",
+    "passwordPASSWORDpassword",
+    "saltSALTsaltSALTsaltSALTsaltSALTsalt",
+    100,
+    96
+};
 
 typedef void (*pbkdf2_func_t)
     (unsigned char *out, size_t outlen,
@@ -239,6 +246,151 @@ static void test_pbkdf2_vector
     }
 }
 
+static const char * const batch_passwords[] = {
+    "password", "passwordPASSWORDpassword", "", "pw",
+    "correct horse battery staple"
+};
+static const char * const batch_salts[] = {
+    "salt", "saltSALTsaltSALTsaltSALTsaltSALTsalt", "s", "", "NaCl"
+};
+#define BATCH_SIZE 5
+
+/* Checks that the batch API gives the same results as one at a time */
+static void test_pbkdf2_batch(void)
+{
+    const unsigned char *password[BATCH_SIZE];
+    const unsigned char *salt[BATCH_SIZE];
+    size_t passwordlen[BATCH_SIZE];
+    size_t saltlen[BATCH_SIZE];
+    unsigned char *out[BATCH_SIZE];
+    unsigned char actual[BATCH_SIZE][MAX_OUT_LEN];
+    unsigned char expected[MAX_OUT_LEN];
+    static const size_t out_lens[] = {16, 32, 40, 96};
+    size_t num, index, len_index;
+    int ok = 1;
+
+    printf("ASCON-PBKDF2 Batch ... ");
+    fflush(stdout);
+
+    for (index = 0; index < BATCH_SIZE; ++index) {
+        password[index] = (const unsigned char *)(batch_passwords[index]);
+        passwordlen[index] = strlen(batch_passwords[index]);
+        salt[index] = (const unsigned char *)(batch_salts[index]);
+        saltlen[index] = strlen(batch_salts[index]);
+        out[index] = actual[index];
+    }
+
+    /* Try all batch sizes so that odd and even counts are covered */
+    for (len_index = 0; len_index < 4; ++len_index) {
+        size_t out_len = out_lens[len_index];
+        for (num = 0; num <= BATCH_SIZE; ++num) {
+            memset(actual, 0xAA, sizeof(actual));
+            ascon_pbkdf2_batch
+                (out, out_len, password, passwordlen, salt, saltlen,
+                 num, 10);
+            for (index = 0; index < BATCH_SIZE; ++index) {
+                if (index < num) {
+                    ascon_pbkdf2
+                        (expected, out_len, password[index],
+                         passwordlen[index], salt[index], saltlen[index],
+                         10);
+                } else {
+                    memset(expected, 0xAA, out_len);
+                }
+                if (test_memcmp(actual[index], expected, out_len) != 0)
+                    ok = 0;
+            }
+        }
+    }
+
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
+/* Simulated non-volatile storage for the calibration tests */
+static unsigned char calibration_memory[ASCON_PBKDF2_CALIBRATION_SIZE];
+static int calibration_writes = 0;
+
+static int calibration_read
+    (const ascon_storage_t *storage, size_t offset,
+     unsigned char *data, size_t size)
+{
+    if (offset >= storage->size || size > (storage->size - offset))
+        return -1;
+    memcpy(data, calibration_memory + offset, size);
+    return (int)size;
+}
+
+static int calibration_write
+    (const ascon_storage_t *storage, size_t offset,
+     const unsigned char *data, size_t size, int erase)
+{
+    if (offset >= storage->size || size > (storage->size - offset))
+        return -1;
+    if (data)
+        memcpy(calibration_memory + offset, data, size);
+    else if (erase)
+        memset(calibration_memory + offset, 0xFF, size);
+    ++calibration_writes;
+    return (int)size;
+}
+
+static ascon_storage_t const calibration_storage = {
+    1, 0, 0, ASCON_PBKDF2_CALIBRATION_SIZE, 0,
+    calibration_read, calibration_write
+};
+
+static void test_pbkdf2_calibrate(const char *name, int variant)
+{
+    unsigned long count, count2;
+    int ok = 1;
+
+    printf("%s Calibrate ... ", name);
+    fflush(stdout);
+
+    /* Measure the iteration count for a 20ms target */
+    count = ascon_pbkdf2_calibrate(20, variant);
+    if (count == 0) {
+        /* No timer on this platform, so nothing more to check */
+        printf("skipped\n");
+        return;
+    }
+
+    /* Check that the result is plausible without depending upon how
+     * busy the machine is.  Every iteration involves several calls to
+     * the permutation, so no machine can do one per nanosecond. */
+    if (count > 20UL * 1000000UL)
+        ok = 0;
+
+    /* The first stored calibration should measure and save the result */
+    memset(calibration_memory, 0xFF, sizeof(calibration_memory));
+    calibration_writes = 0;
+    count = ascon_pbkdf2_calibrate_stored(20, variant, &calibration_storage);
+    if (count == 0 || calibration_writes != 1)
+        ok = 0;
+
+    /* The second should load the saved result without writing */
+    count2 = ascon_pbkdf2_calibrate_stored(20, variant, &calibration_storage);
+    if (count2 != count || calibration_writes != 1)
+        ok = 0;
+
+    /* Changing the target should measure again */
+    count2 = ascon_pbkdf2_calibrate_stored(10, variant, &calibration_storage);
+    if (count2 == 0 || calibration_writes != 2)
+        ok = 0;
+
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
 int main(int argc, char *argv[])
 {
     (void)argc;
@@ -259,6 +411,11 @@ int main(int argc, char *argv[])
     test_pbkdf2_vector
         ("ASCON-PBKDF2", ascon_pbkdf2,
          ASCON_PBKDF2_SIZE, &testVectorPBKDF2_4, 0);
+    test_pbkdf2_vector
+        ("ASCON-PBKDF2", ascon_pbkdf2,
+         ASCON_PBKDF2_SIZE, &testVectorPBKDF2_5, 0);
+    test_pbkdf2_batch();
+    test_pbkdf2_calibrate("ASCON-PBKDF2", ASCON_PBKDF2_CALIBRATE_XOF);
 
     test_pbkdf2_vector
         ("ASCON-PBKDF2-HMAC", ascon_pbkdf2_hmac,
@@ -272,6 +429,10 @@ int main(int argc, char *argv[])
     test_pbkdf2_vector
         ("ASCON-PBKDF2-HMAC", ascon_pbkdf2_hmac,
          ASCON_PBKDF2_SIZE, &testVectorPBKDF2_4, 1);
+    test_pbkdf2_vector
+        ("ASCON-PBKDF2-HMAC", ascon_pbkdf2_hmac,
+         ASCON_PBKDF2_SIZE, &testVectorPBKDF2_5, 1);
+    test_pbkdf2_calibrate("ASCON-PBKDF2-HMAC", ASCON_PBKDF2_CALIBRATE_HMAC);
 
     return test_exit_result;
 }
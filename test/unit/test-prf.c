@@ -0,0 +1,311 @@
+/*
+ * Copyright (C) 2023 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <ascon/prf.h>
+#include <ascon/prf-ctr.h>
+#include "test-cipher.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_MAX_INPUT 80
+#define TEST_MAX_OUTPUT 40
+
+static unsigned char const test_key[ASCON_PRF_KEY_SIZE] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F
+};
+
+/* Checks that a pre-computed key context gives the same output as
+ * starting from the raw key for a range of input lengths */
+static void test_prf_key_context(const char *name, size_t outlen)
+{
+    ascon_prf_key_t key;
+    ascon_prf_state_t state;
+    unsigned char in[TEST_MAX_INPUT];
+    unsigned char expected[TEST_MAX_OUTPUT];
+    unsigned char actual[TEST_MAX_OUTPUT];
+    size_t len;
+    int ok = 1;
+
+    printf("%s Key Context ... ", name);
+    fflush(stdout);
+
+    for (len = 0; len < TEST_MAX_INPUT; ++len)
+        in[len] = (unsigned char)(len * 7 + 3);
+
+    ascon_prf_key_init(&key, test_key, outlen);
+    ascon_prf_init_keyed(&state, &key);
+    for (len = 0; len <= TEST_MAX_INPUT; ++len) {
+        if (outlen)
+            ascon_prf_fixed(expected, outlen, in, len, test_key);
+        else
+            ascon_prf(expected, TEST_MAX_OUTPUT, in, len, test_key);
+
+        /* All-in-one version */
+        memset(actual, 0xAA, sizeof(actual));
+        ascon_prf_with_key
+            (actual, outlen ? outlen : TEST_MAX_OUTPUT, in, len, &key);
+        if (test_memcmp(actual, expected, outlen ? outlen : TEST_MAX_OUTPUT))
+            ok = 0;
+
+        /* Incremental version, resetting the same state for each message */
+        memset(actual, 0xBB, sizeof(actual));
+        ascon_prf_reinit_keyed(&state, &key);
+        ascon_prf_absorb(&state, in, len);
+        ascon_prf_squeeze(&state, actual, outlen ? outlen : TEST_MAX_OUTPUT);
+        if (test_memcmp(actual, expected, outlen ? outlen : TEST_MAX_OUTPUT))
+            ok = 0;
+    }
+    ascon_prf_free(&state);
+    ascon_prf_key_free(&key);
+
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
+/* Checks ASCON-Mac with a pre-computed key context */
+static void test_mac_key_context(void)
+{
+    ascon_prf_key_t key;
+    unsigned char in[TEST_MAX_INPUT];
+    unsigned char expected[ASCON_MAC_TAG_SIZE];
+    unsigned char actual[ASCON_MAC_TAG_SIZE];
+    size_t len;
+    int ok = 1;
+
+    printf("ASCON-Mac Key Context ... ");
+    fflush(stdout);
+
+    for (len = 0; len < TEST_MAX_INPUT; ++len)
+        in[len] = (unsigned char)(len * 5 + 1);
+
+    ascon_prf_key_init(&key, test_key, ASCON_MAC_TAG_SIZE);
+    for (len = 0; len <= TEST_MAX_INPUT; len += 7) {
+        ascon_mac(expected, in, len, test_key);
+        memset(actual, 0xAA, sizeof(actual));
+        ascon_mac_with_key(actual, in, len, &key);
+        if (test_memcmp(actual, expected, sizeof(actual)) != 0)
+            ok = 0;
+        if (ascon_mac_verify_with_key(expected, in, len, &key) != 0)
+            ok = 0;
+        expected[len % ASCON_MAC_TAG_SIZE] ^= 0x01;
+        if (ascon_mac_verify_with_key(expected, in, len, &key) != -1)
+            ok = 0;
+    }
+    ascon_prf_key_free(&key);
+
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
+#define BATCH_SIZE 11
+
+/* Checks batch verification of ASCON-Mac tags */
+static void test_mac_verify_batch(void)
+{
+    unsigned char keys[BATCH_SIZE][ASCON_MAC_KEY_SIZE];
+    unsigned char tags[BATCH_SIZE][ASCON_MAC_TAG_SIZE];
+    unsigned char data[TEST_MAX_INPUT * 2];
+    const unsigned char *tag[BATCH_SIZE];
+    const unsigned char *in[BATCH_SIZE];
+    const unsigned char *key[BATCH_SIZE];
+    size_t inlen[BATCH_SIZE];
+    unsigned char results[(BATCH_SIZE + 7) / 8];
+    unsigned expected = 0;
+    size_t index, posn;
+    int ok = 1;
+
+    printf("ASCON-Mac Verify Batch ... ");
+    fflush(stdout);
+
+    /* Mix up the message lengths so that the pairs of lanes finish
+     * absorbing at different times */
+    for (posn = 0; posn < sizeof(data); ++posn)
+        data[posn] = (unsigned char)(posn * 13 + 7);
+    for (index = 0; index < BATCH_SIZE; ++index) {
+        for (posn = 0; posn < ASCON_MAC_KEY_SIZE; ++posn)
+            keys[index][posn] = (unsigned char)(index * 17 + posn);
+        key[index] = keys[index];
+        in[index] = data + index;
+        inlen[index] = (index * 37) % (TEST_MAX_INPUT + 1);
+        ascon_mac(tags[index], in[index], inlen[index], key[index]);
+        tag[index] = tags[index];
+        expected |= 1U << index;
+    }
+
+    /* Everything should verify */
+    memset(results, 0xAA, sizeof(results));
+    if (ascon_mac_verify_batch(results, tag, in, inlen, key, BATCH_SIZE) != 0)
+        ok = 0;
+    if ((unsigned)(results[0] | (results[1] << 8)) != expected)
+        ok = 0;
+
+    /* Corrupt some of the tags, including both tags in one pair */
+    tags[0][3] ^= 0x01;
+    tags[1][0] ^= 0x40;
+    tags[6][ASCON_MAC_TAG_SIZE - 1] ^= 0x80;
+    tags[10][8] ^= 0x02;
+    expected &= ~((1U << 0) | (1U << 1) | (1U << 6) | (1U << 10));
+    memset(results, 0xAA, sizeof(results));
+    if (ascon_mac_verify_batch(results, tag, in, inlen, key, BATCH_SIZE) != -1)
+        ok = 0;
+    if ((unsigned)(results[0] | (results[1] << 8)) != expected)
+        ok = 0;
+
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
+#define TEST_CTR_BLOCKS 7
+#define TEST_CTR_LEN (TEST_CTR_BLOCKS * ASCON_PRF_CTR_BLOCK_SIZE)
+
+static unsigned char const test_nonce[ASCON_PRF_CTR_NONCE_SIZE] = {
+    0xF0, 0xE1, 0xD2, 0xC3, 0xB4, 0xA5, 0x96, 0x87,
+    0x78, 0x69, 0x5A, 0x4B, 0x3C, 0x2D, 0x1E, 0x0F
+};
+
+/* Computes a counter mode keystream block directly with ASCON-Prf */
+static void test_prf_ctr_block(unsigned char *out, uint64_t block)
+{
+    unsigned char in[ASCON_PRF_CTR_NONCE_SIZE + 8];
+    unsigned index;
+    memcpy(in, test_nonce, ASCON_PRF_CTR_NONCE_SIZE);
+    for (index = 0; index < 8; ++index)
+        in[ASCON_PRF_CTR_NONCE_SIZE + index] =
+            (unsigned char)(block >> (56 - index * 8));
+    ascon_prf_fixed(out, ASCON_PRF_CTR_BLOCK_SIZE, in, sizeof(in), test_key);
+}
+
+static void test_prf_ctr(void)
+{
+    static size_t const chunks[] = {1, 7, 64, 100, 3, 128, 60, 5};
+    ascon_prf_ctr_state_t state;
+    unsigned char expected[TEST_CTR_LEN];
+    unsigned char actual[TEST_CTR_LEN];
+    unsigned char data[TEST_CTR_LEN];
+    uint64_t first = (((uint64_t)1) << 40) - 3;
+    size_t posn, len, index;
+    int ok = 1;
+
+    printf("ASCON-Prf Counter Mode ... ");
+    fflush(stdout);
+
+    ascon_prf_ctr_init(&state, test_key, test_nonce);
+
+    /* Multi-block generation, including a carry between counter bytes */
+    for (index = 0; index < TEST_CTR_BLOCKS; ++index) {
+        test_prf_ctr_block
+            (expected + index * ASCON_PRF_CTR_BLOCK_SIZE, first + index);
+    }
+    for (len = 1; len <= TEST_CTR_BLOCKS; ++len) {
+        memset(actual, 0xAA, sizeof(actual));
+        ascon_prf_ctr_blocks(&state, actual, first, len);
+        if (test_memcmp(actual, expected, len * ASCON_PRF_CTR_BLOCK_SIZE))
+            ok = 0;
+    }
+
+    /* Sequential keystream from the start, in odd-sized pieces */
+    for (index = 0; index < TEST_CTR_BLOCKS; ++index)
+        test_prf_ctr_block(expected + index * ASCON_PRF_CTR_BLOCK_SIZE, index);
+    memset(actual, 0xAA, sizeof(actual));
+    for (posn = 0, index = 0; posn < TEST_CTR_LEN; posn += len, ++index) {
+        len = chunks[index % (sizeof(chunks) / sizeof(chunks[0]))];
+        if (len > (TEST_CTR_LEN - posn))
+            len = TEST_CTR_LEN - posn;
+        ascon_prf_ctr_keystream(&state, actual + posn, len);
+    }
+    if (test_memcmp(actual, expected, TEST_CTR_LEN))
+        ok = 0;
+    if (ascon_prf_ctr_tell(&state) != TEST_CTR_LEN)
+        ok = 0;
+
+    /* Sequential XOR after seeking back into the middle of a block */
+    for (posn = 0; posn < TEST_CTR_LEN; ++posn)
+        data[posn] = (unsigned char)(posn * 11 + 5);
+    ascon_prf_ctr_seek(&state, 37);
+    memcpy(actual, data, TEST_CTR_LEN);
+    for (posn = 37, index = 3; posn < TEST_CTR_LEN; posn += len, ++index) {
+        len = chunks[index % (sizeof(chunks) / sizeof(chunks[0]))];
+        if (len > (TEST_CTR_LEN - posn))
+            len = TEST_CTR_LEN - posn;
+        ascon_prf_ctr_xor(&state, actual + posn, actual + posn, len);
+    }
+    for (posn = 37; posn < TEST_CTR_LEN; ++posn) {
+        if (actual[posn] != (data[posn] ^ expected[posn]))
+            ok = 0;
+    }
+
+    /* Random access to arbitrary byte ranges, decrypting in place */
+    for (posn = 0; posn < TEST_CTR_LEN; posn += 29) {
+        for (len = 0; len <= 150 && (posn + len) <= TEST_CTR_LEN; len += 37) {
+            memcpy(actual, data, TEST_CTR_LEN);
+            ascon_prf_ctr_xor_at(&state, actual, data + posn, len, posn);
+            for (index = 0; index < len; ++index) {
+                if (actual[index] !=
+                        (data[posn + index] ^ expected[posn + index]))
+                    ok = 0;
+            }
+            ascon_prf_ctr_xor_at(&state, actual, actual, len, posn);
+            if (test_memcmp(actual, data + posn, len))
+                ok = 0;
+        }
+    }
+
+    /* The random access functions do not move the position */
+    if (ascon_prf_ctr_tell(&state) != TEST_CTR_LEN)
+        ok = 0;
+    ascon_prf_ctr_free(&state);
+
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    test_prf_key_context("ASCON-Prf", 0);
+    test_prf_key_context("ASCON-Prf Fixed", 32);
+    test_mac_key_context();
+    test_mac_verify_batch();
+    test_prf_ctr();
+
+    return test_exit_result;
+}
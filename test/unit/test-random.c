@@ -0,0 +1,646 @@
+/*
+ * Copyright (C) 2023 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#if defined(HAVE_CONFIG_H)
+#include <config.h>
+#endif
+#include <ascon/random.h>
+#include <ascon/random-dist.h>
+#include "random/ascon-trng.h"
+#include "test-cipher.h"
+#include <stdio.h>
+#include <string.h>
+#if defined(HAVE_PTHREAD_H) && defined(HAVE_LIBPTHREAD)
+#include <pthread.h>
+#define TEST_RANDOM_THREADS 4
+#endif
+#if defined(HAVE_UNISTD_H)
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#define TEST_RANDOM_CALLS 16
+#define TEST_RANDOM_SIZE 16
+
+static void test_random_distinct(void)
+{
+    unsigned char out[TEST_RANDOM_CALLS][TEST_RANDOM_SIZE];
+    int index, index2;
+    int ok = 1;
+
+    printf("ASCON-Random Distinct ... ");
+    fflush(stdout);
+
+    for (index = 0; index < TEST_RANDOM_CALLS; ++index) {
+        if (!ascon_random(out[index], TEST_RANDOM_SIZE))
+            ok = 0;
+    }
+    for (index = 0; index < TEST_RANDOM_CALLS; ++index) {
+        for (index2 = index + 1; index2 < TEST_RANDOM_CALLS; ++index2) {
+            if (!memcmp(out[index], out[index2], TEST_RANDOM_SIZE))
+                ok = 0;
+        }
+    }
+
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
+#define TEST_POOL_OUTPUT 1000
+
+/* Fetches from a pool in chunks of varying sizes */
+static void test_random_pool_chunks
+    (ascon_random_pool_t *pool, unsigned char *out, size_t outlen,
+     const size_t *chunks, size_t num_chunks)
+{
+    size_t posn, len, index;
+    for (posn = 0, index = 0; posn < outlen; posn += len, ++index) {
+        len = chunks[index % num_chunks];
+        if (len > (outlen - posn))
+            len = outlen - posn;
+        ascon_random_pool_fetch(pool, out + posn, len);
+    }
+}
+
+static void test_random_pool(void)
+{
+    static size_t const chunks1[] = {4, 16, 8, 1};
+    static size_t const chunks2[] = {100, 3, 255, 7, 32};
+    ascon_random_pool_t pool1;
+    ascon_random_pool_t pool2;
+    unsigned char out1[TEST_POOL_OUTPUT];
+    unsigned char out2[TEST_POOL_OUTPUT];
+    unsigned index;
+    int ok = 1;
+
+    printf("ASCON-Random Pool ... ");
+    fflush(stdout);
+
+    if (!ascon_random_pool_init(&pool1))
+        ok = 0;
+
+    /* Two copies of the same generator must produce the same stream
+     * regardless of how the requests are split up */
+    ascon_random_pool_fetch(&pool1, out1, 10);
+    memcpy(&pool2, &pool1, sizeof(pool1));
+    test_random_pool_chunks(&pool1, out1, sizeof(out1), chunks1, 4);
+    test_random_pool_chunks(&pool2, out2, sizeof(out2), chunks2, 5);
+    if (test_memcmp(out1, out2, sizeof(out1)))
+        ok = 0;
+
+    /* Bytes that have been returned must be wiped from the pool */
+    if (pool1.posn == 0 || pool1.posn > ASCON_RANDOM_POOL_SIZE)
+        ok = 0;
+    for (index = 0; index < pool1.posn; ++index) {
+        if (pool1.pool[index] != 0)
+            ok = 0;
+    }
+
+    /* Re-seeding and feeding discard the rest of the pool */
+    ascon_random_pool_reseed(&pool1);
+    if (pool1.posn != ASCON_RANDOM_POOL_SIZE)
+        ok = 0;
+    ascon_random_pool_fetch(&pool1, out1, 16);
+    ascon_random_pool_feed(&pool1, out2, 16);
+    if (pool1.posn != ASCON_RANDOM_POOL_SIZE)
+        ok = 0;
+
+    /* Large requests are served directly from the generator */
+    ascon_random_pool_fetch(&pool1, out1, sizeof(out1));
+    if (pool1.posn != ASCON_RANDOM_POOL_SIZE)
+        ok = 0;
+    ascon_random_pool_free(&pool1);
+    ascon_random_pool_free(&pool2);
+
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
+static void test_random_shared(void)
+{
+    unsigned char out[4][TEST_RANDOM_SIZE];
+    int ok = 1;
+
+    printf("ASCON-Random Shared ... ");
+    fflush(stdout);
+
+    if (!ascon_random_shared_fetch(out[0], TEST_RANDOM_SIZE))
+        ok = 0;
+    if (!ascon_random_shared_reseed())
+        ok = 0;
+    if (!ascon_random_shared_fetch(out[1], TEST_RANDOM_SIZE))
+        ok = 0;
+    ascon_random_shared_release();
+    if (!ascon_random_shared_fetch(out[2], TEST_RANDOM_SIZE))
+        ok = 0;
+    if (!ascon_random(out[3], TEST_RANDOM_SIZE))
+        ok = 0;
+    if (!memcmp(out[0], out[1], TEST_RANDOM_SIZE) ||
+            !memcmp(out[1], out[2], TEST_RANDOM_SIZE) ||
+            !memcmp(out[2], out[3], TEST_RANDOM_SIZE))
+        ok = 0;
+
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
+#if defined(TEST_RANDOM_THREADS)
+
+static unsigned char test_thread_output
+    [TEST_RANDOM_THREADS][TEST_RANDOM_CALLS][TEST_RANDOM_SIZE];
+
+static void *test_random_thread(void *arg)
+{
+    unsigned char (*out)[TEST_RANDOM_SIZE] =
+        (unsigned char (*)[TEST_RANDOM_SIZE])arg;
+    int index;
+    for (index = 0; index < TEST_RANDOM_CALLS; ++index)
+        ascon_random_shared_fetch(out[index], TEST_RANDOM_SIZE);
+    return 0;
+}
+
+/* Every thread gets its own independently seeded shard, so no two
+ * threads should produce the same output */
+static void test_random_threads(void)
+{
+    pthread_t threads[TEST_RANDOM_THREADS];
+    int index, index2;
+    int ok = 1;
+
+    printf("ASCON-Random Threads ... ");
+    fflush(stdout);
+
+    for (index = 0; index < TEST_RANDOM_THREADS; ++index) {
+        if (pthread_create(&threads[index], 0, test_random_thread,
+                           test_thread_output[index]) != 0)
+            ok = 0;
+    }
+    for (index = 0; index < TEST_RANDOM_THREADS; ++index)
+        pthread_join(threads[index], 0);
+    for (index = 0; index < TEST_RANDOM_THREADS * TEST_RANDOM_CALLS; ++index) {
+        for (index2 = index + 1;
+                index2 < TEST_RANDOM_THREADS * TEST_RANDOM_CALLS; ++index2) {
+            if (!memcmp(test_thread_output[0][index],
+                        test_thread_output[0][index2], TEST_RANDOM_SIZE))
+                ok = 0;
+        }
+    }
+
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
+#endif
+
+#define TEST_DRBG_LONG 20000
+
+static void test_random_deterministic(void)
+{
+    static unsigned char const seed[16] = "0123456789abcdef";
+    static unsigned char const expected[32] = {
+        0x4f, 0x99, 0x07, 0xac, 0xa2, 0x93, 0xb0, 0x8d,
+        0x11, 0x9f, 0x02, 0xfa, 0x1a, 0xe1, 0x25, 0x24,
+        0xd2, 0x2a, 0xf3, 0x97, 0x87, 0x31, 0x25, 0x9d,
+        0xbd, 0x61, 0xb4, 0x6b, 0xe1, 0xb1, 0xe3, 0xef
+    };
+    static unsigned char long1[TEST_DRBG_LONG];
+    static unsigned char long2[TEST_DRBG_LONG];
+    ascon_random_state_t state1;
+    ascon_random_state_t state2;
+    ascon_random_pool_t pool1;
+    ascon_random_pool_t pool2;
+    unsigned char out1[32];
+    unsigned char out2[32];
+    size_t posn;
+    int ok = 1;
+
+    printf("ASCON-Random Deterministic ... ");
+    fflush(stdout);
+
+    /* Known answer so that the output is the same on every platform */
+    ascon_random_init_deterministic(&state1, seed, sizeof(seed));
+    ascon_random_fetch(&state1, out1, 16);
+    ascon_random_generate(&state1, out1 + 16, 16);
+    if (test_memcmp(out1, expected, sizeof(expected)))
+        ok = 0;
+
+    /* Bulk generation is the same regardless of how it is split up */
+    ascon_random_init_deterministic(&state2, seed, sizeof(seed));
+    ascon_random_fetch(&state2, out2, 16);
+    for (posn = 16; posn < sizeof(out2); posn += 3) {
+        size_t len = sizeof(out2) - posn;
+        ascon_random_generate(&state2, out2 + posn, len < 3 ? len : 3);
+    }
+    if (test_memcmp(out2, expected, sizeof(expected)))
+        ok = 0;
+
+    /* No automatic re-seed from the TRNG after the re-seed limit */
+    ascon_random_fetch(&state1, long1, sizeof(long1));
+    ascon_random_fetch(&state2, long2, sizeof(long2));
+    ascon_random_fetch(&state1, out1, 16);
+    ascon_random_fetch(&state2, out2, 16);
+    if (test_memcmp(out1, out2, 16) || test_memcmp(long1, long2, 16))
+        ok = 0;
+
+    /* Explicit re-seeding mixes in the TRNG and breaks determinism */
+    ascon_random_reseed(&state1);
+    ascon_random_fetch(&state1, out1, 16);
+    ascon_random_fetch(&state2, out2, 16);
+    if (!memcmp(out1, out2, 16))
+        ok = 0;
+    ascon_random_free(&state1);
+    ascon_random_free(&state2);
+
+    /* Seeded buffered generators are also reproducible */
+    ascon_random_pool_init_deterministic(&pool1, seed, sizeof(seed));
+    ascon_random_pool_init_deterministic(&pool2, seed, sizeof(seed));
+    if (ascon_random_pool_uint64(&pool1) != ascon_random_pool_uint64(&pool2) ||
+            ascon_random_pool_range(&pool1, 1000) !=
+                ascon_random_pool_range(&pool2, 1000))
+        ok = 0;
+    ascon_random_pool_free(&pool1);
+    ascon_random_pool_free(&pool2);
+
+    /* Different seeds produce different output */
+    ascon_random_init_deterministic(&state1, seed, sizeof(seed) - 1);
+    ascon_random_fetch(&state1, out1, 16);
+    if (!memcmp(out1, expected, 16))
+        ok = 0;
+    ascon_random_free(&state1);
+
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
+static void test_random_stats(void)
+{
+    static unsigned char out[ASCON_RANDOM_POOL_SIZE * 64];
+    ascon_random_stats_t stats;
+    ascon_random_state_t state;
+    ascon_trng_state_t trng;
+    uint64_t words[4];
+    int ok = 1;
+
+    printf("ASCON-Random Stats ... ");
+    fflush(stdout);
+
+    ascon_random_reset_stats();
+#if defined(ASCON_RANDOM_STATS)
+    /* The instrumented build of this test must exercise the counters */
+    if (!ascon_random_get_stats(&stats))
+        ok = 0;
+#endif
+    if (!ascon_random_get_stats(&stats)) {
+        /* Instrumentation is not compiled in, so everything is zero */
+        ascon_random_init(&state);
+        ascon_random_get_stats(&stats);
+        if (stats.trng_requests != 0 || stats.trng_bytes != 0 ||
+                stats.trng_syscalls != 0 || stats.reseeds != 0 ||
+                stats.auto_reseeds != 0 || stats.rekeys != 0 ||
+                stats.mixer_permutations != 0)
+            ok = 0;
+        ascon_random_free(&state);
+    } else {
+        /* Initializing a generator draws one seed and re-keys once */
+        ascon_random_init(&state);
+        ascon_random_get_stats(&stats);
+        if (stats.trng_requests != 1 || stats.trng_bytes < 32 ||
+                stats.reseeds != 0 || stats.rekeys != 1)
+            ok = 0;
+
+        /* Go past the re-seed limit to force an automatic re-seed */
+        ascon_random_fetch(&state, out, sizeof(out));
+        ascon_random_fetch(&state, out, 16);
+        ascon_random_get_stats(&stats);
+        if (stats.trng_requests != 2 || stats.reseeds != 1 ||
+                stats.auto_reseeds != 1 || stats.rekeys != 4)
+            ok = 0;
+
+        /* Explicit re-seeds are not counted as automatic re-seeds */
+        ascon_random_reseed(&state);
+        ascon_random_get_stats(&stats);
+        if (stats.reseeds != 2 || stats.auto_reseeds != 1)
+            ok = 0;
+        ascon_random_free(&state);
+
+        /* Deterministic generators never touch the TRNG */
+        ascon_random_reset_stats();
+        ascon_random_init_deterministic(&state, out, 16);
+        ascon_random_fetch(&state, out, sizeof(out));
+        ascon_random_fetch(&state, out, 16);
+        ascon_random_get_stats(&stats);
+        if (stats.trng_requests != 0 || stats.trng_bytes != 0 ||
+                stats.trng_syscalls != 0 || stats.auto_reseeds != 0)
+            ok = 0;
+        ascon_random_free(&state);
+
+#if defined(ASCON_TRNG_MIXER)
+        /* Expanding masking material runs the mixer permutation */
+        ascon_random_reset_stats();
+        ascon_trng_init(&trng);
+        ascon_trng_generate_words_64(&trng, words, 4);
+        ascon_random_get_stats(&stats);
+        if (stats.trng_requests != 1 || stats.mixer_permutations != 5)
+            ok = 0;
+        ascon_trng_free(&trng);
+#else
+        (void)trng;
+        (void)words;
+#endif
+
+        /* Resetting the counters sets everything back to zero */
+        ascon_random_reset_stats();
+        ascon_random_get_stats(&stats);
+        if (stats.trng_requests != 0 || stats.rekeys != 0)
+            ok = 0;
+    }
+
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
+#define TEST_TRNG_WORDS 17
+
+static void test_trng_words(void)
+{
+    ascon_trng_state_t trng;
+    uint64_t words[TEST_TRNG_WORDS * 2 + 1];
+    size_t count, index, index2;
+    int ok = 1;
+
+    printf("ASCON-TRNG Word Batches ... ");
+    fflush(stdout);
+
+    ascon_trng_init(&trng);
+    for (count = 0; count <= TEST_TRNG_WORDS; ++count) {
+        /* Mix single words and batches; all words must be distinct
+         * and the batch must not write past the end of the array */
+        words[0] = ascon_trng_generate_64(&trng);
+        words[count + 1] = 0;
+        ascon_trng_generate_words_64(&trng, words + 1, count);
+        if (words[count + 1] != 0)
+            ok = 0;
+        words[count + 1] = ascon_trng_generate_64(&trng);
+        for (index = 0; index < count + 2; ++index) {
+            for (index2 = index + 1; index2 < count + 2; ++index2) {
+                if (words[index] == words[index2])
+                    ok = 0;
+            }
+        }
+    }
+    ascon_trng_free(&trng);
+
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
+#define TEST_DIST_SAMPLES 20000
+#define TEST_DIST_BUCKETS 10
+#define TEST_SHUFFLE_SIZE 100
+
+/* Checks that a set of bucket counts is roughly uniform */
+static int test_dist_uniform(const unsigned *counts, unsigned buckets,
+                             unsigned samples)
+{
+    unsigned expected = samples / buckets;
+    unsigned index;
+    for (index = 0; index < buckets; ++index) {
+        if (counts[index] < (expected - expected / 8) ||
+                counts[index] > (expected + expected / 8))
+            return 0;
+    }
+    return 1;
+}
+
+static void test_random_dist(void)
+{
+    static uint32_t values[TEST_DIST_SAMPLES];
+    static double doubles[TEST_DIST_SAMPLES];
+    unsigned counts[TEST_DIST_BUCKETS];
+    unsigned char shuffled[TEST_SHUFFLE_SIZE];
+    unsigned seen[TEST_SHUFFLE_SIZE];
+    ascon_random_pool_t pool;
+    ascon_random_pool_t pool2;
+    uint64_t big = (((uint64_t)3) << 40) + 7;
+    unsigned index;
+    int ok = 1;
+
+    printf("ASCON-Random Distributions ... ");
+    fflush(stdout);
+
+    ascon_random_pool_init(&pool);
+
+    /* Bulk fill of integers must match individual calls on a copy of
+     * the generator when the request is smaller than the pool.  This
+     * must be done before the automatic re-seed from the TRNG. */
+    memcpy(&pool2, &pool, sizeof(pool));
+    ascon_random_pool_fill_uint32(&pool, values, 50);
+    for (index = 0; index < 50; ++index) {
+        if (values[index] != ascon_random_pool_uint32(&pool2))
+            ok = 0;
+    }
+    ascon_random_pool_free(&pool2);
+
+    /* Single values in a range */
+    memset(counts, 0, sizeof(counts));
+    for (index = 0; index < TEST_DIST_SAMPLES; ++index) {
+        uint32_t x = ascon_random_pool_range(&pool, TEST_DIST_BUCKETS);
+        if (x >= TEST_DIST_BUCKETS)
+            ok = 0;
+        else
+            ++(counts[x]);
+    }
+    if (!test_dist_uniform(counts, TEST_DIST_BUCKETS, TEST_DIST_SAMPLES))
+        ok = 0;
+    if (ascon_random_pool_range(&pool, 0) != 0 ||
+            ascon_random_pool_range(&pool, 1) != 0)
+        ok = 0;
+
+    /* 64-bit ranges, bucketed by the top of the range */
+    memset(counts, 0, sizeof(counts));
+    for (index = 0; index < TEST_DIST_SAMPLES; ++index) {
+        uint64_t x = ascon_random_pool_range64(&pool, big);
+        if (x >= big)
+            ok = 0;
+        else
+            ++(counts[x / (big / TEST_DIST_BUCKETS + 1)]);
+    }
+    if (!test_dist_uniform(counts, TEST_DIST_BUCKETS, TEST_DIST_SAMPLES))
+        ok = 0;
+
+    /* Bulk fill of a range */
+    memset(counts, 0, sizeof(counts));
+    ascon_random_pool_fill_range
+        (&pool, values, TEST_DIST_SAMPLES, TEST_DIST_BUCKETS);
+    for (index = 0; index < TEST_DIST_SAMPLES; ++index) {
+        if (values[index] >= TEST_DIST_BUCKETS)
+            ok = 0;
+        else
+            ++(counts[values[index]]);
+    }
+    if (!test_dist_uniform(counts, TEST_DIST_BUCKETS, TEST_DIST_SAMPLES))
+        ok = 0;
+
+    /* Floating-point values */
+    memset(counts, 0, sizeof(counts));
+    ascon_random_pool_fill_double(&pool, doubles, TEST_DIST_SAMPLES);
+    for (index = 0; index < TEST_DIST_SAMPLES; ++index) {
+        if (doubles[index] < 0.0 || doubles[index] >= 1.0)
+            ok = 0;
+        else
+            ++(counts[(unsigned)(doubles[index] * TEST_DIST_BUCKETS)]);
+    }
+    if (!test_dist_uniform(counts, TEST_DIST_BUCKETS, TEST_DIST_SAMPLES))
+        ok = 0;
+    for (index = 0; index < 100; ++index) {
+        double d = ascon_random_pool_double(&pool);
+        float f = ascon_random_pool_float(&pool);
+        if (d < 0.0 || d >= 1.0 || f < 0.0f || f >= 1.0f)
+            ok = 0;
+    }
+
+    /* Shuffling must produce a permutation of the original array */
+    for (index = 0; index < TEST_SHUFFLE_SIZE; ++index)
+        shuffled[index] = (unsigned char)index;
+    ascon_random_pool_shuffle(&pool, shuffled, TEST_SHUFFLE_SIZE, 1);
+    memset(seen, 0, sizeof(seen));
+    for (index = 0; index < TEST_SHUFFLE_SIZE; ++index)
+        ++(seen[shuffled[index]]);
+    for (index = 0; index < TEST_SHUFFLE_SIZE; ++index) {
+        if (seen[index] != 1)
+            ok = 0;
+    }
+    ascon_random_pool_shuffle(&pool, values, 1000, sizeof(uint32_t));
+
+    ascon_random_pool_free(&pool);
+
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
+#if defined(HAVE_UNISTD_H)
+
+/* The parent and child processes must not produce the same output
+ * after a fork, even if the parent's PRNG was seeded before the fork */
+static void test_random_fork(void)
+{
+    unsigned char parent[TEST_RANDOM_SIZE];
+    unsigned char child[TEST_RANDOM_SIZE];
+    int fds[2];
+    pid_t pid;
+    int ok = 1;
+
+    printf("ASCON-Random Fork ... ");
+    fflush(stdout);
+
+    ascon_random(parent, sizeof(parent));
+    if (pipe(fds) < 0) {
+        printf("skipped\n");
+        return;
+    }
+    pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        printf("skipped\n");
+        return;
+    } else if (pid == 0) {
+        close(fds[0]);
+        ascon_random(child, sizeof(child));
+        if (write(fds[1], child, sizeof(child)) != (ssize_t)sizeof(child))
+            _exit(1);
+        _exit(0);
+    }
+    close(fds[1]);
+    ascon_random(parent, sizeof(parent));
+    if (read(fds[0], child, sizeof(child)) != (ssize_t)sizeof(child))
+        ok = 0;
+    close(fds[0]);
+    waitpid(pid, 0, 0);
+    if (!memcmp(parent, child, sizeof(child)))
+        ok = 0;
+
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
+#endif
+
+int main(int argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    test_random_distinct();
+    test_random_pool();
+    test_random_shared();
+#if defined(TEST_RANDOM_THREADS)
+    test_random_threads();
+#endif
+    test_trng_words();
+    test_random_dist();
+    test_random_deterministic();
+    test_random_stats();
+#if defined(HAVE_UNISTD_H)
+    test_random_fork();
+#endif
+
+    return test_exit_result;
+}
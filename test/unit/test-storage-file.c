@@ -0,0 +1,266 @@
+/*
+ * Copyright (C) 2023 Southern Storm Software, Pty Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+
+#if defined(HAVE_CONFIG_H)
+#include <config.h>
+#endif
+#include <ascon/storage-file.h>
+#include <ascon/random.h>
+#include "test-cipher.h"
+#include <stdio.h>
+#include <string.h>
+#if defined(HAVE_UNISTD_H)
+#include <dirent.h>
+#define TEST_HAVE_DIRENT 1
+#endif
+
+#define TEST_SIZE 600
+
+/* Name of the file to use for the tests, and a file planted next to it.
+ * Derived from the program name so that the static and shared
+ * versions of the test can run in parallel. */
+static char test_file[ASCON_FILE_STORAGE_MAX_PATH];
+static char test_file_tmp[ASCON_FILE_STORAGE_MAX_PATH + 4];
+
+/* Counts the temporary files that were left behind next to the test file,
+ * not including the planted file.  Returns 0 if this cannot be checked. */
+static int test_file_leftovers(void)
+{
+#if defined(TEST_HAVE_DIRENT)
+    char dir[ASCON_FILE_STORAGE_MAX_PATH];
+    const char *name = strrchr(test_file, '/');
+    size_t namelen;
+    struct dirent *entry;
+    DIR *d;
+    int count = 0;
+    if (name) {
+        memcpy(dir, test_file, (size_t)(name - test_file));
+        dir[name - test_file] = '\0';
+        ++name;
+    } else {
+        strcpy(dir, ".");
+        name = test_file;
+    }
+    namelen = strlen(name);
+    d = opendir(dir[0] ? dir : "/");
+    if (!d)
+        return 0;
+    while ((entry = readdir(d)) != 0) {
+        if (!strncmp(entry->d_name, name, namelen) &&
+                entry->d_name[namelen] == '.' &&
+                strcmp(entry->d_name + namelen, ".tmp") != 0)
+            ++count;
+    }
+    closedir(d);
+    return count;
+#else
+    return 0;
+#endif
+}
+
+/* Determine if a file exists */
+static int test_file_exists(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (file) {
+        fclose(file);
+        return 1;
+    }
+    return 0;
+}
+
+static void test_storage_file_read_write(void)
+{
+    ascon_file_storage_t file;
+    const ascon_storage_t *storage = &(file.storage);
+    unsigned char expected[TEST_SIZE];
+    unsigned char actual[TEST_SIZE];
+    unsigned char data[300];
+    unsigned index;
+    FILE *planted;
+    int ok = 1;
+
+    printf("File Storage Read/Write ... ");
+    fflush(stdout);
+
+    remove(test_file);
+    if (ascon_file_storage_init(&file, test_file, TEST_SIZE, 1) < 0) {
+        printf("not supported\n");
+        return;
+    }
+
+    /* Plant a file at the obvious temporary file name; writes must
+     * not truncate or follow it */
+    planted = fopen(test_file_tmp, "wb");
+    if (planted) {
+        fputs("keep", planted);
+        fclose(planted);
+    }
+
+    /* Reading a file that does not exist yet should fail */
+    if ((*(storage->read))(storage, 0, actual, 16) != -1)
+        ok = 0;
+
+    /* Write into the middle, crossing a chunk boundary */
+    for (index = 0; index < sizeof(data); ++index)
+        data[index] = (unsigned char)(index * 3 + 1);
+    memset(expected, 0xFF, sizeof(expected));
+    memcpy(expected + 200, data, sizeof(data));
+    if ((*(storage->write))(storage, 200, data, sizeof(data), 0) != 300)
+        ok = 0;
+    memset(actual, 0xAA, sizeof(actual));
+    if ((*(storage->read))(storage, 0, actual, TEST_SIZE) != TEST_SIZE)
+        ok = 0;
+    if (test_memcmp(actual, expected, TEST_SIZE))
+        ok = 0;
+
+    /* Overwrite part of it and check that the rest is preserved */
+    memcpy(expected + 10, data, 250);
+    if ((*(storage->write))(storage, 10, data, 250, 0) != 250)
+        ok = 0;
+    memset(expected + 550, 0xFF, 50);
+    if ((*(storage->write))(storage, 550, 0, 50, 1) != 50)
+        ok = 0;
+    memset(actual, 0xAA, sizeof(actual));
+    if ((*(storage->read))(storage, 0, actual, TEST_SIZE) != TEST_SIZE)
+        ok = 0;
+    if (test_memcmp(actual, expected, TEST_SIZE))
+        ok = 0;
+    if ((*(storage->read))(storage, 100, actual, 20) != 20)
+        ok = 0;
+    if (test_memcmp(actual, expected + 100, 20))
+        ok = 0;
+
+    /* Out of range requests */
+    if ((*(storage->read))(storage, TEST_SIZE - 10, actual, 11) != -1)
+        ok = 0;
+    if ((*(storage->write))(storage, TEST_SIZE, data, 1, 0) != -1)
+        ok = 0;
+
+    /* The temporary file should not be left behind, and the
+     * planted file should be untouched */
+    if (test_file_leftovers() != 0)
+        ok = 0;
+    planted = fopen(test_file_tmp, "rb");
+    if (!planted || !fgets((char *)actual, 16, planted) ||
+            strcmp((const char *)actual, "keep") != 0)
+        ok = 0;
+    if (planted)
+        fclose(planted);
+    remove(test_file_tmp);
+    if (test_file_exists(test_file_tmp))
+        ok = 0;
+    ascon_file_storage_free(&file);
+
+    /* Batched syncs: writes are still visible straight away */
+    ascon_file_storage_init(&file, test_file, TEST_SIZE, 3);
+    for (index = 0; index < 4; ++index) {
+        data[0] = (unsigned char)index;
+        if ((*(storage->write))(storage, 0, data, 1, 0) != 1)
+            ok = 0;
+        if ((*(storage->read))(storage, 0, actual, 1) != 1 ||
+                actual[0] != index)
+            ok = 0;
+    }
+    if (file.pending != 1)
+        ok = 0;
+    if (ascon_file_storage_sync(&file) != 0 || file.pending != 0)
+        ok = 0;
+    ascon_file_storage_free(&file);
+
+    /* Paths that are too long are rejected */
+    memset(actual, 'a', ASCON_FILE_STORAGE_MAX_PATH);
+    actual[ASCON_FILE_STORAGE_MAX_PATH] = '\0';
+    if (ascon_file_storage_init(&file, (const char *)actual, 16, 1) != -1)
+        ok = 0;
+
+    remove(test_file);
+
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
+static void test_storage_file_seed(void)
+{
+    ascon_file_storage_t file;
+    ascon_random_state_t prng;
+    unsigned char seed1[ASCON_RANDOM_SAVED_SEED_SIZE];
+    unsigned char seed2[ASCON_RANDOM_SAVED_SEED_SIZE];
+    int ok = 1;
+
+    printf("File Storage PRNG Seed ... ");
+    fflush(stdout);
+
+    remove(test_file);
+    if (ascon_file_storage_init
+            (&file, test_file, ASCON_RANDOM_SAVED_SEED_SIZE, 1) < 0) {
+        printf("not supported\n");
+        return;
+    }
+    ascon_random_init(&prng);
+
+    /* No seed the first time, but a new one is saved */
+    if (ascon_random_load_seed(&prng, &(file.storage)) != 0)
+        ok = 0;
+    if ((*(file.storage.read))(&(file.storage), 0, seed1, sizeof(seed1))
+            != (int)sizeof(seed1))
+        ok = 0;
+
+    /* Save and load again */
+    if (ascon_random_save_seed(&prng, &(file.storage)) != 1)
+        ok = 0;
+    if ((*(file.storage.read))(&(file.storage), 0, seed2, sizeof(seed2))
+            != (int)sizeof(seed2))
+        ok = 0;
+    if (!memcmp(seed1, seed2, sizeof(seed1)))
+        ok = 0;
+    if (ascon_random_load_seed(&prng, &(file.storage)) != 1)
+        ok = 0;
+
+    ascon_random_free(&prng);
+    ascon_file_storage_free(&file);
+    remove(test_file);
+
+    if (ok) {
+        printf("ok\n");
+    } else {
+        printf("failed\n");
+        test_exit_result = 1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    (void)argc;
+
+    snprintf(test_file, sizeof(test_file), "%s.dat", argv[0]);
+    snprintf(test_file_tmp, sizeof(test_file_tmp), "%s.tmp", test_file);
+    test_storage_file_read_write();
+    test_storage_file_seed();
+
+    return test_exit_result;
+}